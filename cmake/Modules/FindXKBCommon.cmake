@@ -0,0 +1,47 @@
+#
+# Try to find the xkbcommon library and include path.
+# Once done this will define
+#
+# XKBCOMMON_FOUND
+# XKBCOMMON_INCLUDE_DIR
+# XKBCOMMON_LIBRARY
+#
+
+FIND_PATH(XKBCOMMON_INCLUDE_DIR
+  NAMES
+  xkbcommon/xkbcommon.h
+  PATHS
+  ${CMAKE_INCLUDE_PATH}/include/
+  ~/include/
+  /usr/include/
+  /usr/local/include/
+  /sw/include/
+  /opt/local/include/
+  DOC "The directory where xkbcommon/xkbcommon.h resides")
+FIND_LIBRARY(XKBCOMMON_LIBRARY
+  NAMES xkbcommon
+  PATHS
+  ${CMAKE_LIBRARY_PATH}/lib/
+  ~/lib/
+  /usr/lib64
+  /usr/lib
+  /usr/local/lib64
+  /usr/local/lib
+  /sw/lib
+  /opt/local/lib
+  DOC "The xkbcommon library")
+
+IF(XKBCOMMON_INCLUDE_DIR AND XKBCOMMON_LIBRARY)
+  SET(XKBCOMMON_FOUND 1)
+ELSE(XKBCOMMON_INCLUDE_DIR AND XKBCOMMON_LIBRARY)
+  SET(XKBCOMMON_FOUND 0)
+ENDIF(XKBCOMMON_INCLUDE_DIR AND XKBCOMMON_LIBRARY)
+
+MARK_AS_ADVANCED(XKBCOMMON_INCLUDE_DIR XKBCOMMON_LIBRARY)
+
+IF (XKBCOMMON_FOUND)
+    MESSAGE(STATUS "Found xkbcommon: ${XKBCOMMON_LIBRARY}")
+    MESSAGE(STATUS "   include: ${XKBCOMMON_INCLUDE_DIR}")
+ELSE (XKBCOMMON_FOUND)
+    MESSAGE(STATUS "xkbcommon not found, text input will be read from the terminal")
+ENDIF (XKBCOMMON_FOUND)
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DMABUF_HPP
+#define SFML_DMABUF_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Structure describing a Linux dma-buf image
+///
+////////////////////////////////////////////////////////////
+struct DmaBuf
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    DmaBuf() :
+    width     (0),
+    height    (0),
+    format    (0),
+    planeCount(0),
+    modifier  (InvalidModifier)
+    {
+        for (unsigned int i = 0; i < MaxPlanes; ++i)
+        {
+            fd[i] = -1;
+            offset[i] = 0;
+            pitch[i] = 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const unsigned int MaxPlanes = 4;                            ///< Maximum number of planes of an image
+    static const Uint64 InvalidModifier = (static_cast<Uint64>(1) << 56) - 1; ///< DRM_FORMAT_MOD_INVALID: implicit layout, no modifier
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int width;             ///< Width of the image, in pixels
+    unsigned int height;            ///< Height of the image, in pixels
+    Uint32       format;            ///< DRM fourcc code of the pixel format (see drm_fourcc.h)
+    unsigned int planeCount;        ///< Number of planes used
+    int          fd[MaxPlanes];     ///< File descriptor of the dma-buf holding each plane
+    unsigned int offset[MaxPlanes]; ///< Offset of each plane in its dma-buf, in bytes
+    unsigned int pitch[MaxPlanes];  ///< Length of a row of each plane, in bytes
+    Uint64       modifier;          ///< DRM format modifier describing the tiling of the planes
+};
+
+} // namespace sf
+
+
+#endif // SFML_DMABUF_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \struct sf::DmaBuf
+/// \ingroup graphics
+///
+/// sf::DmaBuf describes an image that lives in one or more
+/// Linux dma-buf file descriptors, as produced by V4L2
+/// cameras (VIDIOC_EXPBUF), hardware video decoders or GBM.
+/// It is passed to sf::Texture::loadFromDmaBuf, which makes
+/// the texture sample the buffer directly, without copying
+/// its pixels.
+///
+/// The format is a DRM fourcc code, such as DRM_FORMAT_XRGB8888
+/// for packed RGB, or DRM_FORMAT_NV12 / DRM_FORMAT_YUV420 for
+/// multi-planar YUV. Most drivers can only sample YUV buffers
+/// through external textures, which SFML doesn't use, and SFML
+/// has no built-in YUV to RGB conversion.
+///
+/// With desktop OpenGL, import each plane as its own
+/// single-channel texture instead (DRM_FORMAT_R8 for luma,
+/// DRM_FORMAT_GR88 for the interleaved NV12 chroma) and convert
+/// to RGB with a sf::Shader.
+///
+/// <b>With the OpenGL ES build, multi-planar YUV buffers can't
+/// be displayed:</b> the planes can still be imported, but
+/// sf::Shader is not available to combine them. Have the
+/// producer output a packed RGB format instead (for example
+/// DRM_FORMAT_XRGB8888 or DRM_FORMAT_RGB565 from the ISP or
+/// the video decoder's output stage).
+///
+/// The file descriptors remain owned by the caller.
+///
+/// \see sf::Texture::loadFromDmaBuf
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCE_HPP
+#define SFML_INSTANCE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Define the transform, color and texture rectangle
+///        of one instance of a mesh
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Instance
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The transform is the identity, the color is white and
+    /// the texture rectangle is (0, 0, 1, 1).
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform
+    ///
+    /// The color is white and the texture rectangle is (0, 0, 1, 1).
+    ///
+    /// \param transform Instance transform
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance(const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform and color
+    ///
+    /// The texture rectangle is (0, 0, 1, 1).
+    ///
+    /// \param transform Instance transform
+    /// \param theColor  Instance color
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance(const Transform& transform, const Color& theColor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instance from its transform, color and texture rectangle
+    ///
+    /// \param transform      Instance transform
+    /// \param theColor       Instance color
+    /// \param theTextureRect Instance texture rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    Instance(const Transform& transform, const Color& theColor, const FloatRect& theTextureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the transform of the instance
+    ///
+    /// Only the 2D affine part of the transform is kept,
+    /// which is all that sf::Transformable produces.
+    ///
+    /// \param transform New transform
+    ///
+    /// \see getTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransform(const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of the instance
+    ///
+    /// \return Transform of the instance
+    ///
+    /// \see setTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform getTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float     matrix[6];   ///< First two rows of the 3x3 transform matrix
+    Color     color;       ///< Color multiplied with the color of the vertices
+    FloatRect textureRect; ///< Offset and scale applied to the texture coordinates of the vertices
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Instance
+/// \ingroup graphics
+///
+/// An instance places one copy of a mesh when the same
+/// geometry is drawn many times with
+/// sf::RenderTarget::drawInstanced, like particles or map
+/// markers. Each instance has its own transform, a color
+/// that is multiplied with the color of the vertices, and a
+/// texture rectangle: the texture coordinates of the mesh
+/// are multiplied by its size and offset by its position.
+/// The default rectangle (0, 0, 1, 1) keeps them unchanged,
+/// while a mesh with texture coordinates from 0 to 1 can
+/// show a different part of a sprite sheet in each instance.
+///
+/// Instances are plain data, they are uploaded as they are
+/// and filling an array of them is all the work needed on
+/// the CPU for each drawn object.
+///
+/// Example:
+/// \code
+/// // a 16x16 quad showing a whole cell of the sprite sheet
+/// sf::Vertex quad[] =
+/// {
+///     sf::Vertex(sf::Vector2f( 0,  0), sf::Vector2f(0, 0)),
+///     sf::Vertex(sf::Vector2f( 0, 16), sf::Vector2f(0, 1)),
+///     sf::Vertex(sf::Vector2f(16,  0), sf::Vector2f(1, 0)),
+///     sf::Vertex(sf::Vector2f(16, 16), sf::Vector2f(1, 1))
+/// };
+///
+/// std::vector<sf::Instance> particles(particleCount);
+/// for (std::size_t i = 0; i < particles.size(); ++i)
+/// {
+///     sf::Transform transform;
+///     transform.translate(positions[i]).rotate(angles[i]);
+///     particles[i] = sf::Instance(transform, colors[i], sf::FloatRect(32 * frames[i], 0, 32, 32));
+/// }
+///
+/// window.drawInstanced(quad, 4, sf::TriangleStrip, &particles[0], particles.size(), &spriteSheet);
+/// \endcode
+///
+/// \see sf::RenderTarget::drawInstanced, sf::Vertex
+///
+////////////////////////////////////////////////////////////
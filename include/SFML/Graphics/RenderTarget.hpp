@@ -38,11 +38,14 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class IndexBuffer;
+class Instance;
 class VertexBuffer;
 
 ////////////////////////////////////////////////////////////
@@ -268,6 +271,127 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer
+    ///
+    /// The vertices of \a vertexBuffer are rendered in the order
+    /// given by \a indexBuffer, with the primitive type of the
+    /// vertex buffer.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Indices of the vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Indices of the vertices to render
+    /// \param firstIndex   Position of the first index to use in the index buffer
+    /// \param indexCount   Number of indices to use
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many instances of primitives defined by an array of vertices
+    ///
+    /// The vertices are drawn once for each instance, with the
+    /// transform, color and texture rectangle of the instance
+    /// applied before the render states (see sf::Instance).
+    ///
+    /// With the programmable render path (see
+    /// ContextSettings::Programmable) and an OpenGL implementation
+    /// that supports instancing, all the instances are rendered
+    /// by the GPU with a single draw call, unless \a states
+    /// contains a shader. Otherwise they are expanded into
+    /// independent primitives on the CPU and drawn like with draw().
+    ///
+    /// \param vertices      Pointer to the vertices of the mesh
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives to draw
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                       const Instance* instances, std::size_t instanceCount,
+                       const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many instances of primitives defined by a vertex buffer
+    ///
+    /// See the other overload for how the instances are applied.
+    /// When they can't be rendered by the GPU, the vertices are
+    /// read back from the vertex buffer, which is slow and not
+    /// possible with OpenGL ES.
+    ///
+    /// \param vertexBuffer  Vertex buffer holding the mesh
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& vertexBuffer, const Instance* instances, std::size_t instanceCount,
+                       const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draws
+    ///
+    /// When batching is enabled, consecutive draws of vertices
+    /// (sprites, shapes, texts, vertex arrays) that use the same
+    /// texture, shader and blend mode are transformed on the CPU
+    /// and collected into a single array, which is rendered with
+    /// one draw call when the states change, when the view
+    /// changes, before the target is cleared, displayed or read
+    /// back, or when flush() is called. Large arrays of vertices
+    /// and vertex buffers are still drawn separately.
+    ///
+    /// Since the draws are deferred, the textures and shaders
+    /// they use must not be modified or destroyed until the batch
+    /// is flushed, and OpenGL commands mixed with SFML drawing
+    /// must be preceded by a call to flush() (pushGLStates and
+    /// resetGLStates do it). Shaders receive the vertices already
+    /// transformed, with an identity model-view matrix.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draws is enabled
+    ///
+    /// \return True if batching is enabled
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the draws collected in the current batch
+    ///
+    /// This function does nothing if batching is disabled or if
+    /// no draw is pending. It only has to be called explicitly
+    /// before modifying a texture or shader used by pending draws,
+    /// before copying the contents of a render window with
+    /// sf::Texture::update, or before issuing OpenGL commands.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -380,17 +504,125 @@ protected:
     /// The derived classes must call this function after the
     /// target is created and ready for drawing.
     ///
+    /// \param programmable Draw through the built-in shader instead
+    ///                     of the fixed-function pipeline when possible
+    ///                     (see ContextSettings::Programmable)
+    ///
+    ////////////////////////////////////////////////////////////
+    void initialize(bool programmable = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clip the rendering to a region of the target
+    ///
+    /// The region is applied whenever this target is cleared or
+    /// drawn to. Other targets rendered in the same context,
+    /// like render textures, are not clipped.
+    ///
+    /// \param rect Region to clip to in pixels, or an empty rectangle to stop clipping
+    ///
     ////////////////////////////////////////////////////////////
-    void initialize();
+    void setScissor(const IntRect& rect);
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices,
+    ///        bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add primitives to the current batch
+    ///
+    /// The vertices are transformed and strips, fans and quads
+    /// are converted to independent lines or triangles, so that
+    /// draws of different types can share a batch.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return False if the primitives can't be batched
+    ///
+    ////////////////////////////////////////////////////////////
+    bool batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                       PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand instances into independent primitives and draw them
+    ///
+    /// \param vertices      Pointer to the vertices of the mesh
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives to draw
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawExpandedInstances(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                               const Instance* instances, std::size_t instanceCount,
+                               const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the built-in shader and vertex buffer of the
+    ///        programmable render path
+    ///
+    /// \return True if the programmable render path can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createPipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup environment for drawing with the built-in shader
+    ///
+    /// \param vertexBuffer OpenGL identifier of the buffer holding the vertices
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupPipelineDraw(unsigned int vertexBuffer, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instances of the primitives with the built-in shader
+    ///
+    /// setupPipelineDraw must be called first.
+    ///
+    /// \param type          Type of primitives to draw
+    /// \param firstVertex   Index of the first vertex to use when drawing
+    /// \param vertexCount   Number of vertices to use when drawing
+    /// \param instances     Pointer to the instances
+    /// \param instanceCount Number of instances in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPipelineInstances(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount,
+                               const Instance* instances, std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Switch from the built-in shader back to the
+    ///        fixed-function pipeline
+    ///
+    ////////////////////////////////////////////////////////////
+    void leavePipeline();
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the scissor region
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyScissor();
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
@@ -442,6 +674,17 @@ private:
     ////////////////////////////////////////////////////////////
     void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives of the bound index buffer
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param indexBuffer Index buffer to draw with, must be bound
+    /// \param firstIndex  Position of the first index to use when drawing
+    /// \param indexCount  Number of indices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawIndexedPrimitives(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up environment after drawing
     ///
@@ -460,21 +703,70 @@ private:
 
         bool      enable;         ///< Is the cache enabled?
         bool      glStatesSet;    ///< Are our internal GL states set yet?
+        Uint64    contextId;      ///< Context our internal GL states were set in
+        bool      fixedFunction;  ///< Does that context have the fixed-function pipeline? (OpenGL ES 2 contexts don't)
         bool      viewChanged;    ///< Has the current view changed since last draw?
+        bool      scissorChanged; ///< Has the scissor region changed since last draw?
         BlendMode lastBlendMode;  ///< Cached blending mode
         Uint64    lastTextureId;  ///< Cached texture
         bool      texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
         bool      useVertexCache; ///< Did we previously use the vertex cache?
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool      pipelineBound;  ///< Are the built-in shader and its vertex attributes in use?
+        bool      useVertexArray; ///< Are the vertex attributes held by our vertex array object?
+        unsigned int pipelineBuffer; ///< Buffer the vertex attributes point into (0 if unknown)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Objects of the programmable render path
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pipeline
+    {
+        bool          requested;          ///< Was the programmable render path requested?
+        bool          enabled;            ///< Is the programmable render path used?
+        Shader*       shader;             ///< Built-in shader (NULL on OpenGL ES, which has no sf::Shader)
+        unsigned int  program;            ///< Program object of the built-in shader
+        VertexBuffer* vertexBuffer;       ///< Buffer the vertices are streamed into
+        VertexBuffer* instanceBuffer;     ///< Buffer the instances are streamed into
+        int           transformLocation;  ///< Location of the uniform combining the view and the transform
+        int           textureLocation;    ///< Location of the uniform converting the texture coordinates
+        int           texturedLocation;   ///< Location of the uniform telling whether a texture is applied
+        Transform     transform;          ///< Current value of the transform uniform
+        Uint64        textureId;          ///< Texture the texture coordinates uniform was computed for
+        unsigned int  vertexArray;        ///< Vertex array object holding the vertex attributes
+        Uint64        vertexArrayContext; ///< Context the vertex array object belongs to
+        unsigned int  vertexArrayBuffer;  ///< Buffer the attributes of the vertex array object point into
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draws collected by automatic batching
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        enum {MaxDrawSize = 1024, MaxSize = 65536};
+
+        bool                enabled;   ///< Are draws collected into batches?
+        std::vector<Vertex> vertices;  ///< Pre-transformed vertices waiting to be drawn
+        PrimitiveType       type;      ///< Type of primitives of the batch (Points, Lines or Triangles)
+        BlendMode           blendMode; ///< Blending mode of the batch
+        const Texture*      texture;   ///< Texture of the batch
+        Uint64              textureId; ///< Cache identifier of the texture
+        const Shader*       shader;    ///< Shader of the batch
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
-    Uint64      m_id;          ///< Unique number that identifies the RenderTarget
+    View                m_defaultView;      ///< Default view
+    View                m_view;             ///< Current view
+    IntRect             m_scissor;          ///< Region the rendering is clipped to (empty if not clipped)
+    StatesCache         m_cache;            ///< Render states cache
+    Batch               m_batch;            ///< Draws waiting to be rendered together
+    Pipeline            m_pipeline;         ///< Built-in shader and buffers of the programmable render path
+    std::vector<Vertex> m_instanceVertices; ///< Instances expanded on the CPU when they can't be drawn by the GPU
+    Uint64              m_id;               ///< Unique number that identifies the RenderTarget
 };
 
 } // namespace sf
@@ -505,6 +797,23 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// Scenes made of many small objects sharing a texture, like
+/// sprites taken from the same sprite sheet, can be rendered
+/// with a few draw calls by enabling automatic batching with
+/// setBatchingEnabled().
+///
+/// Render windows and render textures created with the
+/// sf::ContextSettings::Programmable attribute draw through a
+/// built-in shader, with the vertices streamed into a vertex
+/// buffer and the transforms passed as uniforms, instead of
+/// the fixed-function pipeline. Draws that use a sf::Shader of
+/// your own are rendered the same way with both paths. The
+/// same mesh can then also be drawn many times with a single
+/// draw call with drawInstanced(). With OpenGL ES, the attribute
+/// requests an OpenGL ES 2 context, in which every draw goes
+/// through the built-in shader since it has no fixed-function
+/// pipeline.
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -31,8 +31,11 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Window/Window.hpp>
 #include <string>
+#include <vector>
+#include <deque>
 
 
 namespace sf
@@ -157,6 +160,27 @@ public:
     ////////////////////////////////////////////////////////////
     SFML_DEPRECATED Image capture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Declare a region of the window that changes in
+    ///        the current frame
+    ///
+    /// Once a dirty rectangle has been declared for a frame,
+    /// rendering is clipped to the declared regions (plus the
+    /// regions that changed since the back buffer was last
+    /// displayed, when the backend can tell its age), and
+    /// display() only presents these regions on backends that
+    /// support partial presentation. This saves a lot of memory
+    /// bandwidth on mostly static screens.
+    ///
+    /// Dirty rectangles must be declared before drawing the
+    /// frame, and only apply to it: a frame without dirty
+    /// rectangles is entirely redrawn and presented.
+    ///
+    /// \param rect Region that changes, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void addDirtyRect(const IntRect& rect);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -178,12 +202,25 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window's content is
+    ///        displayed on screen
+    ///
+    /// Forwards the dirty rectangles of the frame to the
+    /// window and stops clipping the rendering to them.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_defaultFrameBuffer; ///< Framebuffer to bind when targeting this window
+    unsigned int         m_defaultFrameBuffer; ///< Framebuffer to bind when targeting this window
+    std::vector<IntRect> m_dirtyRects;         ///< Regions declared dirty in the current frame
+    std::deque<IntRect>  m_damageHistory;      ///< Bounds of the regions changed in the previous frames, most recent first
+    IntRect              m_redrawRegion;       ///< Region rendering is clipped to in the current frame
 };
 
 } // namespace sf
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/DmaBuf.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/GlResource.hpp>
 
@@ -214,6 +215,33 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the texture use a dma-buf image as its pixels
+    ///
+    /// The buffer is imported through EGL_EXT_image_dma_buf_import,
+    /// so the texture samples the memory written by the camera or
+    /// video decoder directly: no pixel is copied, neither by the
+    /// CPU nor by the GPU. Whatever is written to the buffer later
+    /// shows up in the texture as well.
+    ///
+    /// Importing is not free either: when the producer cycles
+    /// through a pool of buffers, import each of them once into
+    /// its own texture and draw the texture of the current frame.
+    ///
+    /// This function requires an EGL based backend (DRM); it
+    /// fails on the others. If it fails, the texture is left
+    /// unchanged. Multi-planar YUV buffers can't be displayed
+    /// with the OpenGL ES build (see sf::DmaBuf).
+    ///
+    /// \param buffer Description of the dma-buf image
+    ///
+    /// \return True if importing was successful
+    ///
+    /// \see loadFromImage, sf::DmaBuf
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromDmaBuf(const DmaBuf& buffer);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
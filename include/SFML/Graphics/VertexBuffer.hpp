@@ -207,6 +207,45 @@ public:
     ////////////////////////////////////////////////////////////
     bool update(const VertexBuffer& vertexBuffer);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append vertices after the ones appended before
+    ///
+    /// This function uses the buffer as a ring to stream vertex
+    /// data that changes every frame: each call copies the
+    /// vertices right after the ones of the previous call and
+    /// gives their position in \p offset, to pass as first vertex
+    /// to RenderTarget::draw.
+    ///
+    /// Unlike update(), it never writes to a region that the GPU
+    /// may still be reading. When the end of the buffer is reached,
+    /// the buffer is orphaned: its storage is replaced by a new one
+    /// and the driver releases the old one once the draws using it
+    /// are done, so appending never waits for the GPU. Vertices
+    /// appended before that can't be drawn anymore. The buffer
+    /// grows if \p vertexCount is larger than its size.
+    ///
+    /// The size given to create() should hold at least one frame
+    /// of vertices, the usage should be set to Stream. Calling
+    /// update() restarts the ring.
+    ///
+    /// \code
+    /// sf::VertexBuffer stream(sf::Triangles, sf::VertexBuffer::Stream);
+    /// stream.create(65536);
+    /// ...
+    /// std::size_t offset;
+    /// if (stream.append(vertices, count, offset))
+    ///     window.draw(stream, offset, count);
+    /// \endcode
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Receives the index of the first copied vertex in the buffer
+    ///
+    /// \return True if the vertices were appended
+    ///
+    ////////////////////////////////////////////////////////////
+    bool append(const Vertex* vertices, std::size_t vertexCount, std::size_t& offset);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -336,6 +375,7 @@ private:
     ////////////////////////////////////////////////////////////
     unsigned int  m_buffer;        ///< Internal buffer identifier
     std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
+    std::size_t   m_streamOffset;  ///< Position in the buffer of the next appended vertices
     PrimitiveType m_primitiveType; ///< Type of primitives to draw
     Usage         m_usage;         ///< How this vertex buffer is to be used
 };
@@ -403,6 +443,6 @@ private:
 /// window.draw(triangles);
 /// \endcode
 ///
-/// \see sf::Vertex, sf::VertexArray
+/// \see sf::Vertex, sf::VertexArray, sf::IndexBuffer
 ///
 ////////////////////////////////////////////////////////////
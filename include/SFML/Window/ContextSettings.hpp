@@ -42,8 +42,9 @@ struct ContextSettings
     enum Attribute
     {
         Default = 0,      ///< Non-debug, compatibility context (this and the core attribute are mutually exclusive)
-        Core    = 1 << 0, ///< Core attribute
-        Debug   = 1 << 2  ///< Debug attribute
+        Core         = 1 << 0, ///< Core attribute
+        Debug        = 1 << 2, ///< Debug attribute
+        Programmable = 1 << 3  ///< Render with shaders instead of the fixed-function pipeline in the graphics module
     };
 
     ////////////////////////////////////////////////////////////
@@ -129,6 +130,21 @@ struct ContextSettings
 /// system, this might be required for advanced OpenGL debugging.
 /// OpenGL debugging is disabled by default.
 ///
+/// Setting the programmable attribute flag makes the render
+/// targets of the graphics module (sf::RenderWindow,
+/// sf::RenderTexture) draw through a built-in shader, vertex
+/// buffers and uniforms instead of the fixed-function client
+/// arrays and matrices, when the OpenGL implementation supports
+/// shaders. With desktop OpenGL the context itself doesn't
+/// change, and drawing with a sf::Shader of your own works the
+/// same in both cases. With OpenGL ES, the flag requests an
+/// OpenGL ES 2 context instead of an OpenGL ES 1 one: it has
+/// no fixed-function pipeline, so every draw goes through the
+/// built-in shader, and your own fixed-function OpenGL calls
+/// (matrices, client arrays, pushGLStates/popGLStates state
+/// saving) don't work in it. sf::Shader is not available in
+/// the OpenGL ES build.
+///
 /// <b>Special Note for OS X:</b>
 /// Apple only supports choosing between either a legacy context
 /// (OpenGL 2.1) or a core context (OpenGL version depends on the
@@ -33,6 +33,7 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Sensor.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -180,6 +181,19 @@ public:
         float z;           ///< Current value of the sensor on Z axis
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Input device connection events parameters
+    ///        (InputDeviceConnected, InputDeviceDisconnected)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct InputDeviceEvent
+    {
+        unsigned int deviceId; ///< Identifier of the device, unique among the connected devices
+        bool         keyboard; ///< Is the device a keyboard?
+        bool         mouse;    ///< Is the device a mouse?
+        bool         touch;    ///< Is the device a touchpad or touchscreen?
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Enumeration of the different types of events
     ///
@@ -209,6 +223,8 @@ public:
         TouchMoved,             ///< A touch moved (data in event.touch)
         TouchEnded,             ///< A touch event ended (data in event.touch)
         SensorChanged,          ///< A sensor value changed (data in event.sensor)
+        InputDeviceConnected,   ///< A keyboard, mouse or touch device was connected (data in event.inputDevice)
+        InputDeviceDisconnected, ///< A keyboard, mouse or touch device was disconnected (data in event.inputDevice)
 
         Count                   ///< Keep last -- the total number of event types
     };
@@ -216,7 +232,8 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    EventType type; ///< Type of the event
+    EventType type;      ///< Type of the event
+    Time      timestamp; ///< Time at which the event occurred, in the time base of sf::Clock (zero if unknown)
 
     union
     {
@@ -232,6 +249,7 @@ public:
         JoystickConnectEvent  joystickConnect;   ///< Joystick (dis)connect event parameters (Event::JoystickConnected, Event::JoystickDisconnected)
         TouchEvent            touch;             ///< Touch events parameters (Event::TouchBegan, Event::TouchMoved, Event::TouchEnded)
         SensorEvent           sensor;            ///< Sensor event parameters (Event::SensorChanged)
+        InputDeviceEvent      inputDevice;       ///< Input device (dis)connect event parameters (Event::InputDeviceConnected, Event::InputDeviceDisconnected)
     };
 };
 
@@ -260,6 +278,16 @@ public:
 /// event.key member, all other members such as event.MouseMove
 /// or event.text will have undefined values.
 ///
+/// The timestamp member tells when the event actually happened,
+/// as reported by the kernel or the display server, which can be
+/// noticeably earlier than the time it was polled. It shares the
+/// monotonic time base of sf::Clock and sf::FrameTiming, so
+/// input-to-display latency is simply
+/// frameTiming.presentTime - event.timestamp. The DRM and X11
+/// backends timestamp their input and window events, and joystick
+/// events are timestamped on Linux; the others, and sensor events,
+/// leave it to zero.
+///
 /// Usage example:
 /// \code
 /// sf::Event event;
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMETIMING_HPP
+#define SFML_FRAMETIMING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Structure describing when the frames of a window
+///        were actually presented on screen
+///
+////////////////////////////////////////////////////////////
+struct FrameTiming
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameTiming() :
+    frameCount     (0),
+    presentTime    (Time::Zero),
+    nextVblank     (Time::Zero),
+    refreshPeriod  (Time::Zero),
+    lateFrames     (0),
+    droppedFrames  (0),
+    missedDeadlines(0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64 frameCount;      ///< Display's vertical blank counter when the last frame was presented
+    Time   presentTime;     ///< Time at which the last frame started being scanned out
+    Time   nextVblank;      ///< Predicted time of the next vertical blank
+    Time   refreshPeriod;   ///< Duration of one refresh cycle of the display
+    Uint64 lateFrames;      ///< Number of frames for which display() had to wait for the screen
+    Uint64 droppedFrames;   ///< Number of rendered frames that never reached the screen
+    Uint64 missedDeadlines; ///< Number of frames that missed the cadence set by sf::Window::setFramerateLimit
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMETIMING_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameTiming
+/// \ingroup window
+///
+/// FrameTiming is returned by sf::Window::getFrameTiming and
+/// reports the timing of the last frame that reached the
+/// screen, as measured by the display hardware (vertical
+/// blank and page flip events) rather than by the application.
+///
+/// All the time values share the time base of sf::Clock (the
+/// monotonic system clock), so they can be subtracted from each
+/// other, or from event timestamps, to measure latencies.
+///
+/// frameCount is incremented by the display once per refresh
+/// cycle: if it grows by more than one between two consecutive
+/// frames, the display repeated a frame (stutter).
+///
+/// Only the DRM backend provides real scanout timing at the
+/// moment; on other backends all the members are zero, except
+/// missedDeadlines which is counted by the window itself.
+///
+/// Usage example:
+/// \code
+/// window.display();
+///
+/// sf::FrameTiming timing = window.getFrameTiming();
+/// if (timing.frameCount > previous.frameCount + 1)
+///     stutters++;
+///
+/// // advance animations to the time the next frame will be seen
+/// animate(timing.nextVblank);
+/// previous = timing;
+/// \endcode
+///
+/// \see sf::Window::getFrameTiming
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INPUTSTATISTICS_HPP
+#define SFML_INPUTSTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Structure describing how the input events were
+///        queued until the application read them
+///
+////////////////////////////////////////////////////////////
+struct InputStatistics
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    InputStatistics() :
+    threaded     (false),
+    queueCapacity(0),
+    maxQueueSize (0),
+    queuedEvents (0),
+    droppedEvents(0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    bool         threaded;      ///< Are the input devices read by a dedicated thread?
+    unsigned int queueCapacity; ///< Number of events the input queue can hold
+    unsigned int maxQueueSize;  ///< Highest number of events waiting in the queue so far
+    Uint64       queuedEvents;  ///< Number of events put in the queue
+    Uint64       droppedEvents; ///< Number of events lost because the queue was full
+};
+
+} // namespace sf
+
+
+#endif // SFML_INPUTSTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::InputStatistics
+/// \ingroup window
+///
+/// InputStatistics is returned by sf::Window::getInputStatistics
+/// and tells whether the application reads its events fast
+/// enough: droppedEvents grows when input events arrive faster
+/// than pollEvent or waitEvent consume them, and maxQueueSize
+/// shows how close the queue came to being full.
+///
+/// Only the udev input backend (DRM and Raspberry Pi) provides
+/// these values at the moment; on other backends all the
+/// members are zero.
+///
+/// Usage example:
+/// \code
+/// sf::InputStatistics stats = window.getInputStatistics();
+/// if (stats.droppedEvents > 0)
+///     std::cout << stats.droppedEvents << " input events lost" << std::endl;
+/// \endcode
+///
+/// \see sf::Window::getInputStatistics
+///
+////////////////////////////////////////////////////////////
@@ -56,9 +56,10 @@ public:
     /// \param modeWidth        Width in pixels
     /// \param modeHeight       Height in pixels
     /// \param modeBitsPerPixel Pixel depths in bits per pixel
+    /// \param modeRefreshRate  Refresh rate in Hz, 0 for any
     ///
     ////////////////////////////////////////////////////////////
-    VideoMode(unsigned int modeWidth, unsigned int modeHeight, unsigned int modeBitsPerPixel = 32);
+    VideoMode(unsigned int modeWidth, unsigned int modeHeight, unsigned int modeBitsPerPixel = 32, unsigned int modeRefreshRate = 0);
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the current desktop video mode
@@ -77,7 +78,9 @@ public:
     /// modes that can be used in fullscreen mode.
     /// The returned array is sorted from best to worst, so that
     /// the first element will always give the best mode (higher
-    /// width, height and bits-per-pixel).
+    /// width, height, bits-per-pixel and refresh rate).
+    /// Modes that only differ by their refresh rate are listed
+    /// once per rate on platforms that report it.
     ///
     /// \return Array containing all the supported fullscreen modes
     ///
@@ -90,6 +93,7 @@ public:
     /// The validity of video modes is only relevant when using
     /// fullscreen windows; otherwise any video mode can be used
     /// with no restriction.
+    /// A refresh rate of 0 matches any refresh rate.
     ///
     /// \return True if the video mode is valid for fullscreen mode
     ///
@@ -102,6 +106,7 @@ public:
     unsigned int width;        ///< Video mode width, in pixels
     unsigned int height;       ///< Video mode height, in pixels
     unsigned int bitsPerPixel; ///< Video mode pixel depth, in bits per pixels
+    unsigned int refreshRate;  ///< Video mode refresh rate, in Hz (0 if unknown or any)
 };
 
 ////////////////////////////////////////////////////////////
@@ -186,8 +191,9 @@ SFML_WINDOW_API bool operator >=(const VideoMode& left, const VideoMode& right);
 /// \class sf::VideoMode
 /// \ingroup window
 ///
-/// A video mode is defined by a width and a height (in pixels)
-/// and a depth (in bits per pixel). Video modes are used to
+/// A video mode is defined by a width and a height (in pixels),
+/// a depth (in bits per pixel) and, on platforms that report
+/// it, a refresh rate (in Hz). Video modes are used to
 /// setup windows (sf::Window) at creation time.
 ///
 /// The main usage of video modes is for fullscreen mode:
@@ -217,7 +223,8 @@ SFML_WINDOW_API bool operator >=(const VideoMode& left, const VideoMode& right);
 ///     sf::VideoMode mode = modes[i];
 ///     std::cout << "Mode #" << i << ": "
 ///               << mode.width << "x" << mode.height << " - "
-///               << mode.bitsPerPixel << " bpp" << std::endl;
+///               << mode.bitsPerPixel << " bpp - "
+///               << mode.refreshRate << " Hz" << std::endl;
 /// }
 ///
 /// // Create a window with the same pixel depth as the desktop
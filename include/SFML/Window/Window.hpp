@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Export.hpp>
 #include <SFML/Window/ContextSettings.hpp>
+#include <SFML/Window/FrameTiming.hpp>
+#include <SFML/Window/InputStatistics.hpp>
 #include <SFML/Window/VideoMode.hpp>
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/WindowStyle.hpp>
@@ -237,6 +239,49 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an event for a limited time and return it
+    ///
+    /// This function behaves like waitEvent(Event&), but gives up
+    /// and returns false when no event was received before
+    /// \a timeout expired. It also returns false as soon as
+    /// wakeUp() is called from another thread.
+    /// \code
+    /// sf::Event event;
+    /// while (window.waitEvent(event, sf::milliseconds(100)))
+    /// {
+    ///    // process event...
+    /// }
+    /// // no event for 100 ms: do some background work
+    /// \endcode
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event
+    ///
+    /// \return True if an event was returned, false otherwise
+    ///
+    /// \see waitEvent, wakeUp
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Interrupt the pending, or else the next, timed call to waitEvent
+    ///
+    /// This function can be called from any thread, for example
+    /// to have the event thread handle data received by another
+    /// thread. waitEvent(Event&, Time) returns false when it is
+    /// interrupted, waitEvent(Event&) keeps waiting for an event.
+    /// If no timed wait is in progress, the next call to
+    /// waitEvent(Event&, Time) that finds no queued event returns
+    /// false immediately, so a wake-up sent right after the
+    /// previous wait returned is not lost.
+    ///
+    /// \see waitEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    void wakeUp();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -348,6 +393,30 @@ public:
     ////////////////////////////////////////////////////////////
     void setMouseCursorVisible(bool visible);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the image of the mouse cursor
+    ///
+    /// \a pixels must be an array of \a width x \a height pixels
+    /// in 32-bits RGBA format. The hotspot is the pixel of the
+    /// image that points at the mouse position.
+    ///
+    /// On backends that support it (DRM), the image is shown on
+    /// the hardware cursor plane and follows the mouse without
+    /// any redraw of the window. Other backends keep the system
+    /// cursor.
+    ///
+    /// \param width   Cursor's width, in pixels
+    /// \param height  Cursor's height, in pixels
+    /// \param pixels  Pointer to the array of pixels in memory. The
+    ///                pixels are copied, so you need not keep the
+    ///                source alive after calling this function.
+    /// \param hotspot Position of the hotspot in the image, in pixels
+    ///
+    /// \see setMouseCursorVisible
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMouseCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot);
+
     ////////////////////////////////////////////////////////////
     /// \brief Grab or release the mouse cursor
     ///
@@ -381,11 +450,14 @@ public:
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// The frames are paced on a fixed cadence: when the display
+    /// reports its refresh timing (DRM), each frame is shown for
+    /// a whole number of refresh cycles (for example 30 FPS on a
+    /// 60 Hz display shows every frame for two cycles); otherwise
+    /// SFML sleeps then spins until each deadline, so that the
+    /// imprecision of sf::sleep doesn't affect the framerate.
+    /// Frames that miss their deadline are counted in
+    /// FrameTiming::missedDeadlines.
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
@@ -462,6 +534,38 @@ public:
     ////////////////////////////////////////////////////////////
     void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing of the last frame presented on screen
+    ///
+    /// The returned values come from the display itself (page
+    /// flip and vertical blank events) and are updated whenever
+    /// a frame reaches the screen, so they can be used to pace
+    /// animations and to measure latency or stutter.
+    /// Backends that don't report scanout timing return a
+    /// structure filled with zeros.
+    ///
+    /// \return Timing of the last presented frame
+    ///
+    /// \see display
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameTiming getFrameTiming() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the input event queue
+    ///
+    /// They tell whether events are lost because they arrive
+    /// faster than pollEvent or waitEvent consume them.
+    /// Backends that don't report them return a structure
+    /// filled with zeros.
+    ///
+    /// \return Statistics of the input event queue
+    ///
+    /// \see pollEvent, waitEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    InputStatistics getInputStatistics() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -497,6 +601,42 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the window's content is
+    ///        displayed on screen
+    ///
+    /// This function is called, with the window active, so that
+    /// derived classes can finish their frame (and declare the
+    /// regions it changed) just before it is presented.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the regions that changed in the frame
+    ///        presented by the next call to display()
+    ///
+    /// Backends that support partial presentation only send
+    /// these regions to the screen. Rectangles are given as
+    /// (left, top, width, height) quadruples in pixels.
+    ///
+    /// \param rects Array of 4 * \a count integers
+    /// \param count Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDamage(const Int32* rects, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer
+    ///
+    /// The age is the number of frames since the content of
+    /// the back buffer was displayed, or 0 if it is undefined.
+    ///
+    /// \return Age of the back buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferAge() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -519,14 +659,24 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the next frame is due according to
+    ///        the framerate limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitForNextFrame();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
-    priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
-    Vector2u          m_size;           ///< Current size of the window
+    priv::WindowImpl* m_impl;            ///< Platform-specific implementation of the window
+    priv::GlContext*  m_context;         ///< Platform-specific implementation of the OpenGL context
+    Clock             m_clock;           ///< Clock for measuring the elapsed time between frames
+    Time              m_frameTimeLimit;  ///< Current framerate limit
+    Time              m_nextFrameTime;   ///< Time at which the next frame is due, on m_clock
+    Uint64            m_lastFrameCount;  ///< Vertical blank counter of the last frame seen by the framerate limit
+    Uint64            m_missedDeadlines; ///< Number of frames that missed the framerate limit cadence
+    Vector2u          m_size;            ///< Current size of the window
 };
 
 } // namespace sf
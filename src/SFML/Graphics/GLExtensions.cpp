@@ -38,10 +38,56 @@
 #endif
 
 
+#ifdef SFML_OPENGL_ES
+
+namespace
+{
+    // Load a function of the context, returns false if it doesn't have it
+    template <typename T>
+    bool loadFunction(T& function, const char* name)
+    {
+        function = reinterpret_cast<T>(sf::Context::getFunction(name));
+
+        return function != NULL;
+    }
+}
+
+#endif // SFML_OPENGL_ES
+
+
 namespace sf
 {
 namespace priv
 {
+#ifdef SFML_OPENGL_ES
+
+////////////////////////////////////////////////////////////
+bool gles2ShaderObjects = false;
+GLuint (GL_APIENTRY* gles2CreateShader)(GLenum) = NULL;
+void   (GL_APIENTRY* gles2ShaderSource)(GLuint, GLsizei, const char* const*, const GLint*) = NULL;
+void   (GL_APIENTRY* gles2CompileShader)(GLuint) = NULL;
+void   (GL_APIENTRY* gles2GetShaderiv)(GLuint, GLenum, GLint*) = NULL;
+void   (GL_APIENTRY* gles2DeleteShader)(GLuint) = NULL;
+GLuint (GL_APIENTRY* gles2CreateProgram)() = NULL;
+void   (GL_APIENTRY* gles2AttachShader)(GLuint, GLuint) = NULL;
+void   (GL_APIENTRY* gles2LinkProgram)(GLuint) = NULL;
+void   (GL_APIENTRY* gles2GetProgramiv)(GLuint, GLenum, GLint*) = NULL;
+void   (GL_APIENTRY* gles2DeleteProgram)(GLuint) = NULL;
+void   (GL_APIENTRY* gles2UseProgram)(GLuint) = NULL;
+GLint  (GL_APIENTRY* gles2GetUniformLocation)(GLuint, const char*) = NULL;
+void   (GL_APIENTRY* gles2Uniform1f)(GLint, GLfloat) = NULL;
+void   (GL_APIENTRY* gles2Uniform4f)(GLint, GLfloat, GLfloat, GLfloat, GLfloat) = NULL;
+void   (GL_APIENTRY* gles2UniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*) = NULL;
+void   (GL_APIENTRY* gles2BindAttribLocation)(GLuint, GLuint, const char*) = NULL;
+void   (GL_APIENTRY* gles2EnableVertexAttribArray)(GLuint) = NULL;
+void   (GL_APIENTRY* gles2DisableVertexAttribArray)(GLuint) = NULL;
+void   (GL_APIENTRY* gles2VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = NULL;
+void   (GL_APIENTRY* gles2VertexAttrib3f)(GLuint, GLfloat, GLfloat, GLfloat) = NULL;
+void   (GL_APIENTRY* gles2VertexAttrib4f)(GLuint, GLfloat, GLfloat, GLfloat, GLfloat) = NULL;
+
+#endif // SFML_OPENGL_ES
+
+
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit()
 {
@@ -85,6 +131,36 @@ void ensureExtensionsInit()
             err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
         }
     }
+#else
+    static bool initialized = false;
+    if (!initialized)
+    {
+        initialized = true;
+
+        // The shader functions are only usable in OpenGL ES 2 contexts,
+        // the caller must check the version of the active context too
+        gles2ShaderObjects = loadFunction(gles2CreateShader, "glCreateShader") &&
+                             loadFunction(gles2ShaderSource, "glShaderSource") &&
+                             loadFunction(gles2CompileShader, "glCompileShader") &&
+                             loadFunction(gles2GetShaderiv, "glGetShaderiv") &&
+                             loadFunction(gles2DeleteShader, "glDeleteShader") &&
+                             loadFunction(gles2CreateProgram, "glCreateProgram") &&
+                             loadFunction(gles2AttachShader, "glAttachShader") &&
+                             loadFunction(gles2LinkProgram, "glLinkProgram") &&
+                             loadFunction(gles2GetProgramiv, "glGetProgramiv") &&
+                             loadFunction(gles2DeleteProgram, "glDeleteProgram") &&
+                             loadFunction(gles2UseProgram, "glUseProgram") &&
+                             loadFunction(gles2GetUniformLocation, "glGetUniformLocation") &&
+                             loadFunction(gles2Uniform1f, "glUniform1f") &&
+                             loadFunction(gles2Uniform4f, "glUniform4f") &&
+                             loadFunction(gles2UniformMatrix4fv, "glUniformMatrix4fv") &&
+                             loadFunction(gles2BindAttribLocation, "glBindAttribLocation") &&
+                             loadFunction(gles2EnableVertexAttribArray, "glEnableVertexAttribArray") &&
+                             loadFunction(gles2DisableVertexAttribArray, "glDisableVertexAttribArray") &&
+                             loadFunction(gles2VertexAttribPointer, "glVertexAttribPointer") &&
+                             loadFunction(gles2VertexAttrib3f, "glVertexAttrib3f") &&
+                             loadFunction(gles2VertexAttrib4f, "glVertexAttrib4f");
+    }
 #endif
 }
 
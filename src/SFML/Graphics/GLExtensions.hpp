@@ -77,6 +77,7 @@
     // 1.1 does not support GL_STREAM_DRAW so we just define it to GL_DYNAMIC_DRAW
     #define GLEXT_vertex_buffer_object                true
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
     #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
@@ -156,6 +157,9 @@
     // Core since 3.0 - NV_copy_buffer
     #define GLEXT_copy_buffer                         false
 
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+
     // Core since 3.0 - EXT_sRGB
     #ifdef GL_EXT_sRGB
         #define GLEXT_texture_sRGB                        GL_EXT_sRGB
@@ -165,6 +169,45 @@
         #define GLEXT_GL_SRGB8_ALPHA8                     0
     #endif
 
+    // Core since 3.0 - OES_element_index_uint
+    #ifdef GL_OES_element_index_uint
+        #define GLEXT_element_index_uint                  GL_OES_element_index_uint
+    #else
+        #define GLEXT_element_index_uint                  false
+    #endif
+
+    // Core since 2.0 - shader objects and generic vertex attributes
+    // Only OpenGL ES 2 contexts support them, and the OpenGL ES 1 library
+    // doesn't export them, so ensureExtensionsInit loads them at runtime
+    #define GLEXT_shader_objects                      sf::priv::gles2ShaderObjects
+    #define GLEXT_vertex_shader                       sf::priv::gles2ShaderObjects
+    #define GLEXT_glCreateShaderObject                sf::priv::gles2CreateShader
+    #define GLEXT_glShaderSource                      sf::priv::gles2ShaderSource
+    #define GLEXT_glCompileShader                     sf::priv::gles2CompileShader
+    #define GLEXT_glGetShaderiv                       sf::priv::gles2GetShaderiv
+    #define GLEXT_glDeleteShader                      sf::priv::gles2DeleteShader
+    #define GLEXT_glCreateProgramObject               sf::priv::gles2CreateProgram
+    #define GLEXT_glAttachObject                      sf::priv::gles2AttachShader
+    #define GLEXT_glLinkProgram                       sf::priv::gles2LinkProgram
+    #define GLEXT_glGetProgramiv                      sf::priv::gles2GetProgramiv
+    #define GLEXT_glDeleteProgram                     sf::priv::gles2DeleteProgram
+    #define GLEXT_glUseProgramObject                  sf::priv::gles2UseProgram
+    #define GLEXT_glGetUniformLocation                sf::priv::gles2GetUniformLocation
+    #define GLEXT_glUniform1f                         sf::priv::gles2Uniform1f
+    #define GLEXT_glUniform4f                         sf::priv::gles2Uniform4f
+    #define GLEXT_glUniformMatrix4fv                  sf::priv::gles2UniformMatrix4fv
+    #define GLEXT_glBindAttribLocation                sf::priv::gles2BindAttribLocation
+    #define GLEXT_glEnableVertexAttribArray           sf::priv::gles2EnableVertexAttribArray
+    #define GLEXT_glDisableVertexAttribArray          sf::priv::gles2DisableVertexAttribArray
+    #define GLEXT_glVertexAttribPointer               sf::priv::gles2VertexAttribPointer
+    #define GLEXT_glVertexAttrib3f                    sf::priv::gles2VertexAttrib3f
+    #define GLEXT_glVertexAttrib4f                    sf::priv::gles2VertexAttrib4f
+    #define GLEXT_GL_FRAGMENT_SHADER                  0x8B30
+    #define GLEXT_GL_VERTEX_SHADER                    0x8B31
+    #define GLEXT_GL_COMPILE_STATUS                   0x8B81
+    #define GLEXT_GL_LINK_STATUS                      0x8B82
+    #define GLEXT_GLhandle                            GLuint
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -176,6 +219,7 @@
     // Core since 1.1
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT
     #define GLEXT_GL_CLAMP                            GL_CLAMP
+    #define GLEXT_element_index_uint                  true
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -213,6 +257,7 @@
     // Core since 1.5 - ARB_vertex_buffer_object
     #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
@@ -267,6 +312,12 @@
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glVertexAttrib3f                    glVertexAttrib3fARB
+    #define GLEXT_glVertexAttrib4f                    glVertexAttrib4fARB
 
     // Core since 2.0 - ARB_fragment_shader
     #define GLEXT_fragment_shader                     sfogl_ext_ARB_fragment_shader
@@ -332,6 +383,28 @@
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 sfogl_ext_ARB_vertex_array_object
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_ext_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+    #define GLEXT_glDrawElementsInstanced             glDrawElementsInstancedARB
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_ext_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    sfogl_ext_ARB_map_buffer_range
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+
 #endif
 
 namespace sf
@@ -345,6 +418,36 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit();
 
+#ifdef SFML_OPENGL_ES
+
+////////////////////////////////////////////////////////////
+// OpenGL ES 2 functions loaded by ensureExtensionsInit
+////////////////////////////////////////////////////////////
+extern bool gles2ShaderObjects;
+extern GLuint (GL_APIENTRY* gles2CreateShader)(GLenum type);
+extern void   (GL_APIENTRY* gles2ShaderSource)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+extern void   (GL_APIENTRY* gles2CompileShader)(GLuint shader);
+extern void   (GL_APIENTRY* gles2GetShaderiv)(GLuint shader, GLenum pname, GLint* params);
+extern void   (GL_APIENTRY* gles2DeleteShader)(GLuint shader);
+extern GLuint (GL_APIENTRY* gles2CreateProgram)();
+extern void   (GL_APIENTRY* gles2AttachShader)(GLuint program, GLuint shader);
+extern void   (GL_APIENTRY* gles2LinkProgram)(GLuint program);
+extern void   (GL_APIENTRY* gles2GetProgramiv)(GLuint program, GLenum pname, GLint* params);
+extern void   (GL_APIENTRY* gles2DeleteProgram)(GLuint program);
+extern void   (GL_APIENTRY* gles2UseProgram)(GLuint program);
+extern GLint  (GL_APIENTRY* gles2GetUniformLocation)(GLuint program, const char* name);
+extern void   (GL_APIENTRY* gles2Uniform1f)(GLint location, GLfloat v0);
+extern void   (GL_APIENTRY* gles2Uniform4f)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+extern void   (GL_APIENTRY* gles2UniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+extern void   (GL_APIENTRY* gles2BindAttribLocation)(GLuint program, GLuint index, const char* name);
+extern void   (GL_APIENTRY* gles2EnableVertexAttribArray)(GLuint index);
+extern void   (GL_APIENTRY* gles2DisableVertexAttribArray)(GLuint index);
+extern void   (GL_APIENTRY* gles2VertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+extern void   (GL_APIENTRY* gles2VertexAttrib3f)(GLuint index, GLfloat x, GLfloat y, GLfloat z);
+extern void   (GL_APIENTRY* gles2VertexAttrib4f)(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+
+#endif // SFML_OPENGL_ES
+
 } // namespace priv
 
 } // namespace sf
@@ -53,6 +53,10 @@ int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -935,6 +939,83 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glIsVertexArray = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsVertexArray"));
+    if (!sf_ptrc_glIsVertexArray)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstancedARB"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstancedARB"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisorARB"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr) = NULL;
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = NULL;
+
+static int Load_ARB_map_buffer_range()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glFlushMappedBufferRange = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr)>(glLoaderGetProcAddress("glFlushMappedBufferRange"));
+    if (!sf_ptrc_glFlushMappedBufferRange)
+        numFailed++;
+
+    sf_ptrc_glMapBufferRange = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, GLbitfield)>(glLoaderGetProcAddress("glMapBufferRange"));
+    if (!sf_ptrc_glMapBufferRange)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -943,7 +1024,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[20] = {
+static sfogl_StrToExtMap ExtensionMap[24] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -963,10 +1044,14 @@ static sfogl_StrToExtMap ExtensionMap[20] = {
     {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
     {"GL_EXT_framebuffer_multisample", &sfogl_ext_EXT_framebuffer_multisample, Load_EXT_framebuffer_multisample},
     {"GL_ARB_copy_buffer", &sfogl_ext_ARB_copy_buffer, Load_ARB_copy_buffer},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays},
+    {"GL_ARB_map_buffer_range", &sfogl_ext_ARB_map_buffer_range, Load_ARB_map_buffer_range}
 };
 
-static int g_extensionMapSize = 20;
+static int g_extensionMapSize = 24;
 
 
 static void ClearExtensionVars()
@@ -991,6 +1076,10 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
 }
 
 
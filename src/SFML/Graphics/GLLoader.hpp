@@ -190,6 +190,10 @@ extern int sfogl_ext_EXT_framebuffer_blit;
 extern int sfogl_ext_EXT_framebuffer_multisample;
 extern int sfogl_ext_ARB_copy_buffer;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_vertex_array_object;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_instanced_arrays;
+extern int sfogl_ext_ARB_map_buffer_range;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -454,6 +458,17 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
+
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_WRITE_BIT 0x0002
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1353,6 +1368,40 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint);
+#define glIsVertexArray sf_ptrc_glIsVertexArray
+#endif // GL_ARB_vertex_array_object
+
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif // GL_ARB_draw_instanced
+
+#ifndef GL_ARB_instanced_arrays
+#define GL_ARB_instanced_arrays 1
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint);
+#define glVertexAttribDivisorARB sf_ptrc_glVertexAttribDivisorARB
+#endif // GL_ARB_instanced_arrays
+
+#ifndef GL_ARB_map_buffer_range
+#define GL_ARB_map_buffer_range 1
+extern void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr);
+#define glFlushMappedBufferRange sf_ptrc_glFlushMappedBufferRange
+extern void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+#define glMapBufferRange sf_ptrc_glMapBufferRange
+#endif // GL_ARB_map_buffer_range
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Instance.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Instance::Instance() :
+color      (255, 255, 255),
+textureRect(0, 0, 1, 1)
+{
+    setTransform(Transform::Identity);
+}
+
+
+////////////////////////////////////////////////////////////
+Instance::Instance(const Transform& transform) :
+color      (255, 255, 255),
+textureRect(0, 0, 1, 1)
+{
+    setTransform(transform);
+}
+
+
+////////////////////////////////////////////////////////////
+Instance::Instance(const Transform& transform, const Color& theColor) :
+color      (theColor),
+textureRect(0, 0, 1, 1)
+{
+    setTransform(transform);
+}
+
+
+////////////////////////////////////////////////////////////
+Instance::Instance(const Transform& transform, const Color& theColor, const FloatRect& theTextureRect) :
+color      (theColor),
+textureRect(theTextureRect)
+{
+    setTransform(transform);
+}
+
+
+////////////////////////////////////////////////////////////
+void Instance::setTransform(const Transform& transform)
+{
+    // The 4x4 matrix of sf::Transform is stored by columns
+    const float* m = transform.getMatrix();
+
+    matrix[0] = m[0]; matrix[1] = m[4]; matrix[2] = m[12];
+    matrix[3] = m[1]; matrix[4] = m[5]; matrix[5] = m[13];
+}
+
+
+////////////////////////////////////////////////////////////
+Transform Instance::getTransform() const
+{
+    return Transform(matrix[0], matrix[1], matrix[2],
+                     matrix[3], matrix[4], matrix[5],
+                     0.f,       0.f,       1.f);
+}
+
+} // namespace sf
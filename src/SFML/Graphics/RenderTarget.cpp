@@ -27,6 +27,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/Instance.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
@@ -39,6 +41,7 @@
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 #include <map>
 
 
@@ -50,6 +53,17 @@
 #endif // SFML_OPENGL_ES
 
 
+#if (defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)) && !defined(SFML_OPENGL_ES)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+
 namespace
 {
     // Mutex to protect ID generation and our context-RenderTarget-map
@@ -119,6 +133,322 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // Convert an sf::PrimitiveType constant to the corresponding OpenGL constant.
+    GLenum primitiveTypeToGlConstant(sf::PrimitiveType type)
+    {
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+
+        return modes[type];
+    }
+
+
+    // Get the type of independent primitives that a primitive type is converted to when batched
+    sf::PrimitiveType getBatchType(sf::PrimitiveType type)
+    {
+        switch (type)
+        {
+            case sf::Points:    return sf::Points;
+            case sf::Lines:
+            case sf::LineStrip: return sf::Lines;
+            default:            return sf::Triangles;
+        }
+    }
+
+
+    // Get the number of vertices that primitives take once converted to independent ones
+    std::size_t getBatchVertexCount(sf::PrimitiveType type, std::size_t vertexCount)
+    {
+        switch (type)
+        {
+            case sf::Points:        return vertexCount;
+            case sf::Lines:         return vertexCount - vertexCount % 2;
+            case sf::LineStrip:     return vertexCount < 2 ? 0 : (vertexCount - 1) * 2;
+            case sf::Triangles:     return vertexCount - vertexCount % 3;
+            case sf::TriangleStrip:
+            case sf::TriangleFan:   return vertexCount < 3 ? 0 : (vertexCount - 2) * 3;
+            case sf::Quads:         return vertexCount / 4 * 6;
+        }
+
+        return 0;
+    }
+
+
+    // Get the indices of the vertices that primitives take once converted
+    // to independent ones, in the same order as batchVertices adds them
+    void getBatchIndices(std::vector<std::size_t>& indices, sf::PrimitiveType type, std::size_t vertexCount)
+    {
+        indices.clear();
+        indices.reserve(getBatchVertexCount(type, vertexCount));
+
+        switch (type)
+        {
+            case sf::Points:
+            case sf::Lines:
+            case sf::Triangles:
+            {
+                for (std::size_t i = 0; i < getBatchVertexCount(type, vertexCount); ++i)
+                    indices.push_back(i);
+                break;
+            }
+
+            case sf::LineStrip:
+            {
+                for (std::size_t i = 0; i + 1 < vertexCount; ++i)
+                {
+                    indices.push_back(i);
+                    indices.push_back(i + 1);
+                }
+                break;
+            }
+
+            case sf::TriangleStrip:
+            {
+                for (std::size_t i = 0; i + 2 < vertexCount; ++i)
+                {
+                    indices.push_back(i + (i % 2));
+                    indices.push_back(i + 1 - (i % 2));
+                    indices.push_back(i + 2);
+                }
+                break;
+            }
+
+            case sf::TriangleFan:
+            {
+                for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+                {
+                    indices.push_back(0);
+                    indices.push_back(i);
+                    indices.push_back(i + 1);
+                }
+                break;
+            }
+
+            case sf::Quads:
+            {
+                for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+                {
+                    indices.push_back(i);
+                    indices.push_back(i + 1);
+                    indices.push_back(i + 2);
+                    indices.push_back(i);
+                    indices.push_back(i + 2);
+                    indices.push_back(i + 3);
+                }
+                break;
+            }
+        }
+    }
+
+
+    // Append a transformed vertex to a batch
+    void appendVertex(std::vector<sf::Vertex>& batch, const sf::Vertex& vertex, const sf::Transform& transform)
+    {
+        batch.push_back(sf::Vertex(transform.transformPoint(vertex.position), vertex.color, vertex.texCoords));
+    }
+
+
+    // Has the programmable render path been used by any render target?
+    // The fixed-function path must then reset the states it leaves behind
+    bool pipelineUsed = false;
+
+    // Number of vertices in the ring of the stream buffer of the programmable
+    // render path, it grows if a single draw needs more (20 bytes each)
+    const std::size_t pipelineStreamSize = 16384;
+
+    // Locations of the vertex attributes of the built-in shader,
+    // position must use location 0 in compatibility contexts
+    enum
+    {
+        PositionAttribute        = 0,
+        ColorAttribute           = 1,
+        TexCoordsAttribute       = 2,
+        InstanceRow0Attribute    = 3,
+        InstanceRow1Attribute    = 4,
+        InstanceColorAttribute   = 5,
+        InstanceTextureAttribute = 6
+    };
+
+    // Source code of the built-in shader, the texture coordinates are
+    // converted from pixels like the texture matrix of sf::Texture::bind does
+    // The instance attributes keep constant identity values outside of drawInstanced
+    // It compiles both as GLSL 1.10 and as GLSL ES 1.00 (#version 100)
+    const char* pipelineVertexShader =
+        "uniform mat4 sf_transform;\n"
+        "uniform vec4 sf_texture;\n"
+        "attribute vec2 sf_position;\n"
+        "attribute vec4 sf_color;\n"
+        "attribute vec2 sf_texCoords;\n"
+        "attribute vec3 sf_instanceRow0;\n"
+        "attribute vec3 sf_instanceRow1;\n"
+        "attribute vec4 sf_instanceColor;\n"
+        "attribute vec4 sf_instanceTexture;\n"
+        "varying vec4 sf_vertexColor;\n"
+        "varying vec2 sf_vertexTexCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 position = vec3(sf_position, 1.0);\n"
+        "    vec2 instancePosition = vec2(dot(sf_instanceRow0, position), dot(sf_instanceRow1, position));\n"
+        "    gl_Position = sf_transform * vec4(instancePosition, 0.0, 1.0);\n"
+        "    sf_vertexColor = sf_color * sf_instanceColor;\n"
+        "    vec2 texCoords = sf_instanceTexture.xy + sf_texCoords * sf_instanceTexture.zw;\n"
+        "    sf_vertexTexCoords = texCoords * sf_texture.xy + sf_texture.zw;\n"
+        "}\n";
+
+    const char* pipelineFragmentShader =
+        "#ifdef GL_ES\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "uniform sampler2D sf_sampler;\n"
+        "uniform float sf_textured;\n"
+        "varying vec4 sf_vertexColor;\n"
+        "varying vec2 sf_vertexTexCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 texel = mix(vec4(1.0), texture2D(sf_sampler, sf_vertexTexCoords), sf_textured);\n"
+        "    gl_FragColor = sf_vertexColor * texel;\n"
+        "}\n";
+
+
+    // Check if instances can be drawn by the GPU in the current context
+    bool isInstancingAvailable()
+    {
+        #ifndef SFML_OPENGL_ES
+            return GLEXT_draw_instanced && GLEXT_instanced_arrays;
+        #else
+            return false;
+        #endif
+    }
+
+
+    // Give the instance attributes of the built-in shader the values of an
+    // identity instance, which the draws without instances use
+    void resetInstanceAttributes()
+    {
+        glCheck(GLEXT_glVertexAttrib3f(InstanceRow0Attribute, 1.f, 0.f, 0.f));
+        glCheck(GLEXT_glVertexAttrib3f(InstanceRow1Attribute, 0.f, 1.f, 0.f));
+        glCheck(GLEXT_glVertexAttrib4f(InstanceColorAttribute, 1.f, 1.f, 1.f, 1.f));
+        glCheck(GLEXT_glVertexAttrib4f(InstanceTextureAttribute, 0.f, 0.f, 1.f, 1.f));
+    }
+
+
+    // Delete a vertex array object if the context that created it is active,
+    // it is destroyed along with that context otherwise
+    void destroyVertexArray(unsigned int vertexArray, sf::Uint64 contextId)
+    {
+        #ifndef SFML_OPENGL_ES
+            if (vertexArray && (sf::Context::getActiveContextId() == contextId))
+                glCheck(GLEXT_glDeleteVertexArrays(1, &vertexArray));
+        #else
+            (void)vertexArray;
+            (void)contextId;
+        #endif
+    }
+
+
+    // Bind the attributes of the built-in shader to their fixed locations and
+    // link it, so that they can be enabled and disabled without knowing which
+    // target used them
+    bool linkPipelineProgram(GLEXT_GLhandle program)
+    {
+        glCheck(GLEXT_glBindAttribLocation(program, PositionAttribute, "sf_position"));
+        glCheck(GLEXT_glBindAttribLocation(program, ColorAttribute, "sf_color"));
+        glCheck(GLEXT_glBindAttribLocation(program, TexCoordsAttribute, "sf_texCoords"));
+        glCheck(GLEXT_glBindAttribLocation(program, InstanceRow0Attribute, "sf_instanceRow0"));
+        glCheck(GLEXT_glBindAttribLocation(program, InstanceRow1Attribute, "sf_instanceRow1"));
+        glCheck(GLEXT_glBindAttribLocation(program, InstanceColorAttribute, "sf_instanceColor"));
+        glCheck(GLEXT_glBindAttribLocation(program, InstanceTextureAttribute, "sf_instanceTexture"));
+        glCheck(GLEXT_glLinkProgram(program));
+
+        GLint success;
+        #ifndef SFML_OPENGL_ES
+            glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        #else
+            glCheck(GLEXT_glGetProgramiv(program, GLEXT_GL_LINK_STATUS, &success));
+        #endif
+
+        if (success == GL_FALSE)
+        {
+            sf::err() << "Failed to link the built-in shader of the programmable render path" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+
+    #ifdef SFML_OPENGL_ES
+
+    // Check if the active context is an OpenGL ES 2 context, which has no
+    // fixed-function pipeline ("OpenGL ES-CM 1.1" against "OpenGL ES 2.0")
+    bool isProgrammableContext()
+    {
+        const GLubyte* version = glGetString(GL_VERSION);
+        if (!version)
+            return false;
+
+        while (*version && ((*version < '0') || (*version > '9')))
+            ++version;
+
+        return *version >= '2';
+    }
+
+
+    // Compile a stage of the built-in shader, sf::Shader is not available on OpenGL ES
+    GLuint compilePipelineShader(GLenum type, const char* source)
+    {
+        GLuint shader = GLEXT_glCreateShaderObject(type);
+        glCheck(GLEXT_glShaderSource(shader, 1, &source, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        GLint success;
+        glCheck(GLEXT_glGetShaderiv(shader, GLEXT_GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            sf::err() << "Failed to compile the built-in shader of the programmable render path" << std::endl;
+            glCheck(GLEXT_glDeleteShader(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+
+
+    // Create the program of the built-in shader, not linked yet
+    GLuint createPipelineProgram()
+    {
+        GLuint vertexShader = compilePipelineShader(GLEXT_GL_VERTEX_SHADER, pipelineVertexShader);
+        GLuint fragmentShader = compilePipelineShader(GLEXT_GL_FRAGMENT_SHADER, pipelineFragmentShader);
+        GLuint program = 0;
+
+        if (vertexShader && fragmentShader)
+        {
+            program = GLEXT_glCreateProgramObject();
+            glCheck(GLEXT_glAttachObject(program, vertexShader));
+            glCheck(GLEXT_glAttachObject(program, fragmentShader));
+        }
+
+        // The attached shaders are deleted along with the program
+        if (vertexShader)
+            glCheck(GLEXT_glDeleteShader(vertexShader));
+        if (fragmentShader)
+            glCheck(GLEXT_glDeleteShader(fragmentShader));
+
+        return program;
+    }
+
+
+    // Delete the program of the built-in shader if an OpenGL ES 2 context is
+    // active, it is destroyed along with the shared contexts otherwise
+    void destroyPipelineProgram(GLuint program)
+    {
+        if (program && isProgrammableContext())
+            glCheck(GLEXT_glDeleteProgram(program));
+    }
+
+    #endif // SFML_OPENGL_ES
 }
 
 
@@ -128,24 +458,70 @@ namespace sf
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
+m_scissor    (),
 m_cache      (),
+m_batch      (),
 m_id         (0)
 {
     m_cache.glStatesSet = false;
+    m_cache.contextId = 0;
+    m_cache.fixedFunction = true;
+    m_cache.scissorChanged = false;
+
+    m_cache.pipelineBound = false;
+    m_cache.useVertexArray = false;
+    m_cache.pipelineBuffer = 0;
+
+    m_batch.enabled = false;
+    m_batch.type = Triangles;
+    m_batch.texture = NULL;
+    m_batch.textureId = 0;
+    m_batch.shader = NULL;
+
+    m_pipeline.requested = false;
+    m_pipeline.enabled = false;
+    m_pipeline.shader = NULL;
+    m_pipeline.program = 0;
+    m_pipeline.vertexBuffer = NULL;
+    m_pipeline.instanceBuffer = NULL;
+    m_pipeline.transformLocation = -1;
+    m_pipeline.textureLocation = -1;
+    m_pipeline.texturedLocation = -1;
+    m_pipeline.textureId = 0;
+    m_pipeline.vertexArray = 0;
+    m_pipeline.vertexArrayContext = 0;
+    m_pipeline.vertexArrayBuffer = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    destroyVertexArray(m_pipeline.vertexArray, m_pipeline.vertexArrayContext);
+
+    #ifdef SFML_OPENGL_ES
+        destroyPipelineProgram(m_pipeline.program);
+    #endif
+
+    delete m_pipeline.shader;
+    delete m_pipeline.vertexBuffer;
+    delete m_pipeline.instanceBuffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Draws made before clearing may be outside of the scissor box
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
+        // Clear only the region this target is clipped to, the scissor
+        // test may have been left enabled by another target in the context
+        if (!m_cache.enable || m_cache.scissorChanged)
+            applyScissor();
+
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
@@ -158,6 +534,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // The batched vertices are projected with the view they were drawn with
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -259,8 +638,360 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
+    if (m_batch.enabled)
+    {
+        if (batchVertices(vertices, vertexCount, type, states))
+            return;
+
+        // Keep the drawing order
+        flush();
+    }
+
+    drawVertices(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount || !vertexBuffer.getNativeHandle())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Vertex buffers are never batched, draw what was batched before
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // Draw with the built-in shader if there's no shader of the user
+        if (m_pipeline.enabled && !states.shader)
+        {
+            setupPipelineDraw(vertexBuffer.getNativeHandle(), states);
+            drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+            cleanupDraw(states);
+            return;
+        }
+
+        setupDraw(false, states);
+
+        // Bind vertex buffer
+        VertexBuffer::bind(&vertexBuffer);
+
+        // Always enable texture coordinates
+        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+
+        // Unbind vertex buffer
+        VertexBuffer::bind(NULL);
+
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex,
+                        std::size_t indexCount, const RenderStates& states)
+{
+    // IndexBuffer not supported?
+    if (!IndexBuffer::isAvailable())
+    {
+        err() << "sf::IndexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstIndex > indexBuffer.getIndexCount())
+        return;
+
+    // Clamp indexCount to something that makes sense
+    indexCount = std::min(indexCount, indexBuffer.getIndexCount() - firstIndex);
+
+    // Nothing to draw?
+    if (!indexCount || !vertexBuffer.getNativeHandle() || !indexBuffer.getNativeHandle())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Vertex buffers are never batched, draw what was batched before
+    flush();
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // Draw with the built-in shader if there's no shader of the user
+        if (m_pipeline.enabled && !states.shader)
+        {
+            setupPipelineDraw(vertexBuffer.getNativeHandle(), states);
+
+            // The index buffer binding belongs to the bound vertex array
+            // object, unbind it so that the next draws don't source it
+            IndexBuffer::bind(&indexBuffer);
+            drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), indexBuffer, firstIndex, indexCount);
+            IndexBuffer::bind(NULL);
+
+            cleanupDraw(states);
+            return;
+        }
+
+        setupDraw(false, states);
+
+        // Bind vertex and index buffers
+        VertexBuffer::bind(&vertexBuffer);
+        IndexBuffer::bind(&indexBuffer);
+
+        // Always enable texture coordinates
+        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+        drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), indexBuffer, firstIndex, indexCount);
+
+        // Unbind vertex and index buffers
+        IndexBuffer::bind(NULL);
+        VertexBuffer::bind(NULL);
+
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                 const Instance* instances, std::size_t instanceCount,
+                                 const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !instances || (instanceCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // Render all the instances with a single draw call if possible
+        if (m_pipeline.enabled && !states.shader && isInstancingAvailable())
+        {
+            // Keep the drawing order
+            flush();
+
+            setupPipelineDraw(m_pipeline.vertexBuffer->getNativeHandle(), states);
+
+            std::size_t offset = 0;
+            if (m_pipeline.vertexBuffer->append(vertices, vertexCount, offset))
+                drawPipelineInstances(type, offset, vertexCount, instances, instanceCount);
+
+            cleanupDraw(states);
+            return;
+        }
+    }
+
+    drawExpandedInstances(vertices, vertexCount, type, instances, instanceCount, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const VertexBuffer& vertexBuffer, const Instance* instances, std::size_t instanceCount,
+                                 const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Nothing to draw?
+    std::size_t vertexCount = vertexBuffer.getVertexCount();
+    if (!vertexCount || !vertexBuffer.getNativeHandle() || !instances || (instanceCount == 0))
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // Render all the instances with a single draw call if possible
+        if (m_pipeline.enabled && !states.shader && isInstancingAvailable())
+        {
+            // Keep the drawing order
+            flush();
+
+            setupPipelineDraw(vertexBuffer.getNativeHandle(), states);
+            drawPipelineInstances(vertexBuffer.getPrimitiveType(), 0, vertexCount, instances, instanceCount);
+            cleanupDraw(states);
+            return;
+        }
+
+        #ifndef SFML_OPENGL_ES
+
+            // Read the vertices back to expand the instances on the CPU
+            std::vector<Vertex> vertices(vertexCount);
+
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.getNativeHandle()));
+
+            void* source = 0;
+            glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
+
+            if (source)
+            {
+                std::memcpy(&vertices[0], source, sizeof(Vertex) * vertexCount);
+                glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+            }
+
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+            if (source)
+                drawExpandedInstances(&vertices[0], vertexCount, vertexBuffer.getPrimitiveType(), instances, instanceCount, states);
+
+        #else
+
+            err() << "Instances of a sf::VertexBuffer can't be expanded on OpenGL ES platforms, drawing skipped" << std::endl;
+
+        #endif
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batch.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    // Nothing to draw?
+    if (m_batch.vertices.empty())
+        return;
+
+    // Take the vertices out of the batch first, the first draw resets
+    // the GL states, which flushes again
+    std::vector<Vertex> vertices;
+    vertices.swap(m_batch.vertices);
+
+    // The vertices are already transformed
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, m_batch.shader);
+    drawVertices(&vertices[0], vertices.size(), m_batch.type, states);
+
+    // Keep the memory for the next batch
+    vertices.clear();
+    m_batch.vertices.swap(vertices);
+    m_batch.texture = NULL;
+    m_batch.shader = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states)
+{
+    if (isActive(m_id) || setActive(true))
+    {
+        // First set the persistent OpenGL states if it's the very first call
+        if (!m_cache.glStatesSet)
+            resetGLStates();
+
+        // Stream the vertices to the built-in shader if there's no shader of the user,
+        // the transform is then applied by the shader
+        if (m_pipeline.enabled && !states.shader)
+        {
+            setupPipelineDraw(m_pipeline.vertexBuffer->getNativeHandle(), states);
+
+            // Append the vertices to the ring of the stream buffer, so that
+            // we never wait for the draws reading the previous ones
+            std::size_t offset = 0;
+            if (m_pipeline.vertexBuffer->append(vertices, vertexCount, offset))
+                drawPrimitives(type, offset, vertexCount);
+
+            cleanupDraw(states);
+            return;
+        }
+
         // Check if the vertex count is low enough so that we can pre-transform them
         bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
 
@@ -318,75 +1049,107 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         m_cache.useVertexCache = useVertexCache;
         m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
     }
-}
-
-
-////////////////////////////////////////////////////////////
-void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
-{
-    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
-}
-
-
-////////////////////////////////////////////////////////////
-void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
-                        std::size_t vertexCount, const RenderStates& states)
-{
-    // VertexBuffer not supported?
-    if (!VertexBuffer::isAvailable())
-    {
-        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
-        return;
-    }
-
-    // Sanity check
-    if (firstVertex > vertexBuffer.getVertexCount())
-        return;
-
-    // Clamp vertexCount to something that makes sense
-    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
-
-    // Nothing to draw?
-    if (!vertexCount || !vertexBuffer.getNativeHandle())
-        return;
-
-    // GL_QUADS is unavailable on OpenGL ES
-    #ifdef SFML_OPENGL_ES
-        if (vertexBuffer.getPrimitiveType() == Quads)
-        {
-            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
-            return;
-        }
-    #endif
+}
 
-    if (isActive(m_id) || setActive(true))
-    {
-        setupDraw(false, states);
 
-        // Bind vertex buffer
-        VertexBuffer::bind(&vertexBuffer);
 
-        // Always enable texture coordinates
-        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
-            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+////////////////////////////////////////////////////////////
+bool RenderTarget::batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    // Large arrays are cheaper to transform on the GPU, and textures of
+    // render textures can change before the batch is drawn
+    if ((vertexCount > Batch::MaxDrawSize) || (states.texture && states.texture->m_fboAttachment))
+        return false;
+
+    std::size_t batchCount = getBatchVertexCount(type, vertexCount);
+    PrimitiveType batchType = getBatchType(type);
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+
+    // Start a new batch if the states change or the batch is full
+    if (!m_batch.vertices.empty() &&
+        ((batchType != m_batch.type) ||
+         (states.texture != m_batch.texture) ||
+         (textureId != m_batch.textureId) ||
+         (states.shader != m_batch.shader) ||
+         (states.blendMode != m_batch.blendMode) ||
+         (m_batch.vertices.size() + batchCount > Batch::MaxSize)))
+        flush();
+
+    if (m_batch.vertices.empty())
+    {
+        m_batch.type = batchType;
+        m_batch.blendMode = states.blendMode;
+        m_batch.texture = states.texture;
+        m_batch.textureId = textureId;
+        m_batch.shader = states.shader;
+    }
 
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+    std::vector<Vertex>& batch = m_batch.vertices;
+    const Transform& transform = states.transform;
+    batch.reserve(batch.size() + batchCount);
 
-        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+    switch (type)
+    {
+        case Points:
+        case Lines:
+        case Triangles:
+        {
+            for (std::size_t i = 0; i < batchCount; ++i)
+                appendVertex(batch, vertices[i], transform);
+            break;
+        }
 
-        // Unbind vertex buffer
-        VertexBuffer::bind(NULL);
+        case LineStrip:
+        {
+            for (std::size_t i = 0; i + 1 < vertexCount; ++i)
+            {
+                appendVertex(batch, vertices[i], transform);
+                appendVertex(batch, vertices[i + 1], transform);
+            }
+            break;
+        }
 
-        cleanupDraw(states);
+        case TriangleStrip:
+        {
+            // Every other triangle is reversed to keep the winding of the strip
+            for (std::size_t i = 0; i + 2 < vertexCount; ++i)
+            {
+                appendVertex(batch, vertices[i + (i % 2)], transform);
+                appendVertex(batch, vertices[i + 1 - (i % 2)], transform);
+                appendVertex(batch, vertices[i + 2], transform);
+            }
+            break;
+        }
 
-        // Update the cache
-        m_cache.useVertexCache = false;
-        m_cache.texCoordsArrayEnabled = true;
+        case TriangleFan:
+        {
+            for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+            {
+                appendVertex(batch, vertices[0], transform);
+                appendVertex(batch, vertices[i], transform);
+                appendVertex(batch, vertices[i + 1], transform);
+            }
+            break;
+        }
+
+        case Quads:
+        {
+            for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+            {
+                appendVertex(batch, vertices[i], transform);
+                appendVertex(batch, vertices[i + 1], transform);
+                appendVertex(batch, vertices[i + 2], transform);
+                appendVertex(batch, vertices[i], transform);
+                appendVertex(batch, vertices[i + 2], transform);
+                appendVertex(batch, vertices[i + 3], transform);
+            }
+            break;
+        }
     }
-}
 
+    return true;
+}
 
 ////////////////////////////////////////////////////////////
 bool RenderTarget::setActive(bool active)
@@ -423,6 +1186,13 @@ bool RenderTarget::setActive(bool active)
         }
     }
 
+    #ifdef SFML_OPENGL_ES
+        // OpenGL ES 1 and 2 contexts need different render paths, select
+        // it again along with the default states in another context
+        if (active && (m_cache.contextId != Context::getActiveContextId()))
+            m_cache.glStatesSet = false;
+    #endif
+
     return true;
 }
 
@@ -430,6 +1200,8 @@ bool RenderTarget::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         #ifdef SFML_DEBUG
@@ -443,16 +1215,25 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
+        // Don't save our own shader and vertex attributes with the user's states
+        if (m_cache.pipelineBound)
+            leavePipeline();
+
         #ifndef SFML_OPENGL_ES
             glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
             glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
         #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+
+        // OpenGL ES 2 contexts have no matrix stacks
+        if (m_cache.fixedFunction)
+        {
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
     }
 
     resetGLStates();
@@ -464,12 +1245,19 @@ void RenderTarget::popGLStates()
 {
     if (isActive(m_id) || setActive(true))
     {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
+        // The built-in shader and vertex attributes are not part of the saved states
+        if (m_cache.pipelineBound)
+            leavePipeline();
+
+        if (m_cache.fixedFunction)
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+        }
         #ifndef SFML_OPENGL_ES
             glCheck(glPopClientAttrib());
             glCheck(glPopAttrib());
@@ -481,6 +1269,8 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    flush();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable = Shader::isAvailable();
     bool vertexBufferAvailable = VertexBuffer::isAvailable();
@@ -496,25 +1286,40 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // OpenGL ES 2 contexts have no fixed-function pipeline
+        #ifdef SFML_OPENGL_ES
+            m_cache.contextId = Context::getActiveContextId();
+            m_cache.fixedFunction = !isProgrammableContext();
+        #endif
+
+        // Unbind the built-in shader and vertex attributes of the programmable render path
+        if (pipelineUsed)
+            leavePipeline();
+
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            if (m_cache.fixedFunction)
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
         }
 
         // Define the default OpenGL states
         glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
         glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glLoadIdentity());
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+        if (m_cache.fixedFunction)
+        {
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glLoadIdentity());
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
@@ -530,8 +1335,27 @@ void RenderTarget::resetGLStates()
 
         m_cache.useVertexCache = false;
 
+        // Create the built-in shader of the programmable render path the first time
+        #ifndef SFML_OPENGL_ES
+            if (m_pipeline.requested && !m_pipeline.enabled)
+                m_pipeline.enabled = shaderAvailable && vertexBufferAvailable && createPipeline();
+        #else
+            // OpenGL ES 2 contexts can only draw with the built-in shader and OpenGL ES 1
+            // contexts can't use it, so the context selects the render path
+            m_pipeline.enabled = !m_cache.fixedFunction && GLEXT_shader_objects && vertexBufferAvailable && createPipeline();
+        #endif
+
+        if (m_pipeline.requested && !m_pipeline.enabled)
+        {
+            err() << "The programmable render path is not available, "
+                  << "falling back to the fixed-function pipeline" << std::endl;
+
+            m_pipeline.requested = false;
+        }
+
         // Set the default view
         setView(getView());
+        applyScissor();
 
         m_cache.enable = true;
     }
@@ -539,7 +1363,7 @@ void RenderTarget::resetGLStates()
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::initialize()
+void RenderTarget::initialize(bool programmable)
 {
     // Setup the default and current views
     m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
@@ -548,12 +1372,362 @@ void RenderTarget::initialize()
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
 
+    // The render path is selected on first draw too, the built-in shader
+    // is kept but vertex array objects belong to the previous context
+    m_pipeline.requested = programmable;
+    m_pipeline.enabled = false;
+    destroyVertexArray(m_pipeline.vertexArray, m_pipeline.vertexArrayContext);
+    m_pipeline.vertexArray = 0;
+
+    // Draws collected before the target was (re)created are lost
+    m_batch.vertices.clear();
+    m_batch.texture = NULL;
+    m_batch.shader = NULL;
+
     // Generate a unique ID for this RenderTarget to track
     // whether it is active within a specific context
     m_id = getUniqueId();
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setScissor(const IntRect& rect)
+{
+    // Draws made before are clipped to the previous region
+    flush();
+
+    m_scissor = rect;
+    m_cache.scissorChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawExpandedInstances(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                         const Instance* instances, std::size_t instanceCount,
+                                         const RenderStates& states)
+{
+    // Convert the mesh to independent primitives, so that the instances can follow each other
+    std::vector<std::size_t> indices;
+    getBatchIndices(indices, type, vertexCount);
+
+    if (indices.empty())
+        return;
+
+    m_instanceVertices.resize(indices.size() * instanceCount);
+    Vertex* output = &m_instanceVertices[0];
+
+    for (std::size_t i = 0; i < instanceCount; ++i)
+    {
+        const Instance& instance = instances[i];
+        const float* matrix = instance.matrix;
+        const FloatRect& rect = instance.textureRect;
+
+        for (std::size_t j = 0; j < indices.size(); ++j)
+        {
+            const Vertex& vertex = vertices[indices[j]];
+
+            output->position.x = matrix[0] * vertex.position.x + matrix[1] * vertex.position.y + matrix[2];
+            output->position.y = matrix[3] * vertex.position.x + matrix[4] * vertex.position.y + matrix[5];
+            output->color = vertex.color * instance.color;
+            output->texCoords.x = rect.left + vertex.texCoords.x * rect.width;
+            output->texCoords.y = rect.top + vertex.texCoords.y * rect.height;
+            ++output;
+        }
+    }
+
+    draw(&m_instanceVertices[0], m_instanceVertices.size(), getBatchType(type), states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::createPipeline()
+{
+    if (!m_pipeline.program)
+    {
+        VertexBuffer* vertexBuffer = new VertexBuffer(VertexBuffer::Stream);
+        VertexBuffer* instanceBuffer = new VertexBuffer(VertexBuffer::Stream);
+
+        #ifndef SFML_OPENGL_ES
+            Shader* shader = new Shader;
+            GLEXT_GLhandle program = 0;
+            if (shader->loadFromMemory(pipelineVertexShader, pipelineFragmentShader))
+                program = castToGlHandle(shader->getNativeHandle());
+        #else
+            GLEXT_GLhandle program = createPipelineProgram();
+        #endif
+
+        if (!program || !linkPipelineProgram(program) ||
+            !vertexBuffer->create(pipelineStreamSize) || !instanceBuffer->create(0))
+        {
+            #ifndef SFML_OPENGL_ES
+                delete shader;
+            #else
+                if (program)
+                    glCheck(GLEXT_glDeleteProgram(program));
+            #endif
+            delete vertexBuffer;
+            delete instanceBuffer;
+            return false;
+        }
+
+        m_pipeline.transformLocation = GLEXT_glGetUniformLocation(program, "sf_transform");
+        m_pipeline.textureLocation = GLEXT_glGetUniformLocation(program, "sf_texture");
+        m_pipeline.texturedLocation = GLEXT_glGetUniformLocation(program, "sf_textured");
+
+        // Start with the identity transform and no texture, which the cached values describe
+        glCheck(GLEXT_glUseProgramObject(program));
+        glCheck(GLEXT_glUniformMatrix4fv(m_pipeline.transformLocation, 1, GL_FALSE, Transform::Identity.getMatrix()));
+        glCheck(GLEXT_glUniform4f(m_pipeline.textureLocation, 0.f, 0.f, 0.f, 0.f));
+        glCheck(GLEXT_glUniform1f(m_pipeline.texturedLocation, 0.f));
+        glCheck(GLEXT_glUseProgramObject(0));
+
+        #ifndef SFML_OPENGL_ES
+            m_pipeline.shader = shader;
+            m_pipeline.program = shader->getNativeHandle();
+        #else
+            m_pipeline.program = program;
+        #endif
+        m_pipeline.vertexBuffer = vertexBuffer;
+        m_pipeline.instanceBuffer = instanceBuffer;
+        m_pipeline.transform = Transform::Identity;
+        m_pipeline.textureId = 0;
+    }
+
+    pipelineUsed = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupPipelineDraw(unsigned int vertexBuffer, const RenderStates& states)
+{
+    // Switch from the fixed-function pipeline to the built-in shader
+    if (!m_cache.enable || !m_cache.pipelineBound)
+    {
+        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_pipeline.program)));
+
+        // Current attribute values are not kept by the program, set them again
+        resetInstanceAttributes();
+
+        bool created = false;
+
+        #ifndef SFML_OPENGL_ES
+
+            // Vertex array objects are not shared between contexts,
+            // only use ours in the context that created it
+            Uint64 contextId = Context::getActiveContextId();
+
+            if (GLEXT_vertex_array_object && !m_pipeline.vertexArray)
+            {
+                glCheck(GLEXT_glGenVertexArrays(1, &m_pipeline.vertexArray));
+                m_pipeline.vertexArrayContext = contextId;
+                m_pipeline.vertexArrayBuffer = 0;
+                created = true;
+            }
+
+            m_cache.useVertexArray = m_pipeline.vertexArray && (m_pipeline.vertexArrayContext == contextId);
+
+            if (m_cache.useVertexArray)
+            {
+                // The client arrays of the fixed-function pipeline stay
+                // untouched in the default vertex array object
+                glCheck(GLEXT_glBindVertexArray(m_pipeline.vertexArray));
+                m_cache.pipelineBuffer = m_pipeline.vertexArrayBuffer;
+            }
+            else
+            {
+                if (GLEXT_vertex_array_object)
+                    glCheck(GLEXT_glBindVertexArray(0));
+
+                glCheck(glDisableClientState(GL_VERTEX_ARRAY));
+                glCheck(glDisableClientState(GL_COLOR_ARRAY));
+                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+                m_cache.pipelineBuffer = 0;
+            }
+
+        #else
+
+            // Vertex array objects are optional on OpenGL ES 2 (OES_vertex_array_object),
+            // the attributes are pointed into the buffers without them, and the
+            // contexts that can use the built-in shader have no client arrays
+            m_cache.useVertexArray = false;
+            m_cache.pipelineBuffer = 0;
+
+        #endif
+
+        if (!m_cache.useVertexArray || created)
+        {
+            glCheck(GLEXT_glEnableVertexAttribArray(PositionAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+        }
+
+        m_cache.pipelineBound = true;
+    }
+
+    // Apply the view
+    if (!m_cache.enable || m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the scissor region
+    if (!m_cache.enable || m_cache.scissorChanged)
+        applyScissor();
+
+    // Apply the blend mode
+    if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
+        applyBlendMode(states.blendMode);
+
+    // Apply the texture, see setupDraw for render textures
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment) || (textureId != m_cache.lastTextureId))
+        applyTexture(states.texture);
+
+    // Convert the texture coordinates from pixels to normalized coordinates in the shader
+    if (textureId != m_pipeline.textureId)
+    {
+        if (states.texture)
+        {
+            const Texture& texture = *states.texture;
+            float scaleX = 1.f / texture.m_actualSize.x;
+            float scaleY = 1.f / texture.m_actualSize.y;
+            float offsetY = 0.f;
+
+            // If pixels are flipped we must invert the Y axis
+            if (texture.m_pixelsFlipped)
+            {
+                scaleY = -scaleY;
+                offsetY = static_cast<float>(texture.m_size.y) / texture.m_actualSize.y;
+            }
+
+            glCheck(GLEXT_glUniform4f(m_pipeline.textureLocation, scaleX, scaleY, 0.f, offsetY));
+        }
+
+        glCheck(GLEXT_glUniform1f(m_pipeline.texturedLocation, states.texture ? 1.f : 0.f));
+        m_pipeline.textureId = textureId;
+    }
+
+    // Combine the view and the transform in a single uniform
+    Transform transform = m_view.getTransform() * states.transform;
+    if (transform != m_pipeline.transform)
+    {
+        glCheck(GLEXT_glUniformMatrix4fv(m_pipeline.transformLocation, 1, GL_FALSE, transform.getMatrix()));
+        m_pipeline.transform = transform;
+    }
+
+    // Point the vertex attributes into the buffer if they don't already
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer));
+
+    if (vertexBuffer != m_cache.pipelineBuffer)
+    {
+        glCheck(GLEXT_glVertexAttribPointer(PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(GLEXT_glVertexAttribPointer(ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(GLEXT_glVertexAttribPointer(TexCoordsAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+        // Buffers of the user may be deleted and their identifier reused,
+        // only remember our own
+        m_cache.pipelineBuffer = (vertexBuffer == m_pipeline.vertexBuffer->getNativeHandle()) ? vertexBuffer : 0;
+
+        if (m_cache.useVertexArray)
+            m_pipeline.vertexArrayBuffer = m_cache.pipelineBuffer;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPipelineInstances(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount,
+                                         const Instance* instances, std::size_t instanceCount)
+{
+    #ifndef SFML_OPENGL_ES
+
+        // Stream the instances, orphaning the previous storage like for the vertices
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_pipeline.instanceBuffer->getNativeHandle()));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Instance) * instanceCount, instances, GLEXT_GL_STREAM_DRAW));
+
+        // Point the instance attributes into them, advancing once per instance
+        glCheck(GLEXT_glVertexAttribPointer(InstanceRow0Attribute, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast<const void*>(0)));
+        glCheck(GLEXT_glVertexAttribPointer(InstanceRow1Attribute, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast<const void*>(12)));
+        glCheck(GLEXT_glVertexAttribPointer(InstanceColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), reinterpret_cast<const void*>(24)));
+        glCheck(GLEXT_glVertexAttribPointer(InstanceTextureAttribute, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast<const void*>(28)));
+
+        for (GLuint attribute = InstanceRow0Attribute; attribute <= InstanceTextureAttribute; ++attribute)
+        {
+            glCheck(GLEXT_glEnableVertexAttribArray(attribute));
+            glCheck(GLEXT_glVertexAttribDivisor(attribute, 1));
+        }
+
+        glCheck(GLEXT_glDrawArraysInstanced(primitiveTypeToGlConstant(type), static_cast<GLint>(firstVertex),
+                                            static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount)));
+
+        // Go back to the identity instance for the other draws
+        for (GLuint attribute = InstanceRow0Attribute; attribute <= InstanceTextureAttribute; ++attribute)
+        {
+            glCheck(GLEXT_glVertexAttribDivisor(attribute, 0));
+            glCheck(GLEXT_glDisableVertexAttribArray(attribute));
+        }
+
+        resetInstanceAttributes();
+
+    #else
+
+        (void)type;
+        (void)firstVertex;
+        (void)vertexCount;
+        (void)instances;
+        (void)instanceCount;
+
+    #endif
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::leavePipeline()
+{
+    #ifndef SFML_OPENGL_ES
+
+        if (GLEXT_vertex_array_object)
+            glCheck(GLEXT_glBindVertexArray(0));
+
+        // Generic attribute 0 aliases the vertex array, disable the attributes first
+        if (GLEXT_vertex_shader)
+        {
+            glCheck(GLEXT_glDisableVertexAttribArray(PositionAttribute));
+            glCheck(GLEXT_glDisableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glDisableVertexAttribArray(TexCoordsAttribute));
+        }
+
+        if (GLEXT_shader_objects)
+            glCheck(GLEXT_glUseProgramObject(0));
+
+        if (GLEXT_vertex_buffer_object)
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+        glCheck(glEnableClientState(GL_COLOR_ARRAY));
+        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    #else
+
+        // Only OpenGL ES 2 contexts run the built-in shader,
+        // and they have no client arrays to enable again
+        if (!m_cache.fixedFunction)
+        {
+            glCheck(GLEXT_glDisableVertexAttribArray(PositionAttribute));
+            glCheck(GLEXT_glDisableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glDisableVertexAttribArray(TexCoordsAttribute));
+            glCheck(GLEXT_glUseProgramObject(0));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+        }
+
+    #endif
+
+    // The client array pointers must be set again
+    m_cache.pipelineBound = false;
+    m_cache.texCoordsArrayEnabled = true;
+    m_cache.useVertexCache = false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -562,17 +1736,40 @@ void RenderTarget::applyCurrentView()
     int top = getSize().y - (viewport.top + viewport.height);
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
-    // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    // OpenGL ES 2 contexts have no matrices, the built-in shader applies the view
+    if (m_cache.fixedFunction)
+    {
+        // Set the projection matrix
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
 
     m_cache.viewChanged = false;
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::applyScissor()
+{
+    if ((m_scissor.width > 0) && (m_scissor.height > 0))
+    {
+        // The scissor box is in OpenGL coordinates (origin at the bottom-left corner)
+        int top = getSize().y - (m_scissor.top + m_scissor.height);
+        glCheck(glEnable(GL_SCISSOR_TEST));
+        glCheck(glScissor(m_scissor.left, top, m_scissor.width, m_scissor.height));
+    }
+    else
+    {
+        glCheck(glDisable(GL_SCISSOR_TEST));
+    }
+
+    m_cache.scissorChanged = false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyBlendMode(const BlendMode& mode)
 {
@@ -636,7 +1833,12 @@ void RenderTarget::applyTransform(const Transform& transform)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    // The built-in shader converts the texture coordinates in OpenGL ES 2
+    // contexts, which have no texture matrix
+    if (m_cache.fixedFunction)
+        Texture::bind(texture, Texture::Pixels);
+    else
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture ? texture->m_texture : 0));
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
 }
@@ -656,6 +1858,11 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     if (!m_cache.glStatesSet)
         resetGLStates();
 
+    // Go back to the fixed-function pipeline if the built-in shader of this
+    // render target, or of another one in the same context, was used before
+    if (m_cache.enable ? m_cache.pipelineBound : pipelineUsed)
+        leavePipeline();
+
     if (useVertexCache)
     {
         // Since vertices are transformed, we must use an identity transform to render them
@@ -671,6 +1878,10 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     if (!m_cache.enable || m_cache.viewChanged)
         applyCurrentView();
 
+    // Apply the scissor region
+    if (!m_cache.enable || m_cache.scissorChanged)
+        applyScissor();
+
     // Apply the blend mode
     if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
         applyBlendMode(states.blendMode);
@@ -703,15 +1914,26 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
 void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
 {
     // Find the OpenGL primitive type
-    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-    GLenum mode = modes[type];
+    GLenum mode = primitiveTypeToGlConstant(type);
 
     // Draw the primitives
     glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::drawIndexedPrimitives(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount)
+{
+    // Find the OpenGL primitive and index types
+    GLenum mode = primitiveTypeToGlConstant(type);
+    GLenum indexType = (indexBuffer.getIndexType() == IndexBuffer::Index32) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    std::size_t indexSize = (indexType == GL_UNSIGNED_INT) ? sizeof(Uint32) : sizeof(Uint16);
+
+    // Draw the primitives, the offset is in bytes into the bound index buffer
+    glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), indexType, reinterpret_cast<const void*>(firstIndex * indexSize)));
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::cleanupDraw(const RenderStates& states)
 {
@@ -766,4 +1988,23 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Batching
+//   When enabled, small draws are pre-transformed like with the
+//   vertex cache and appended to a batch as long as they use
+//   the same texture, shader and blending mode. Strips, fans
+//   and quads are converted to independent primitives so that
+//   sprites, shapes and texts can end up in the same batch.
+//   Everything that depends on the drawing order (other draws,
+//   view and GL state changes, clear, display) flushes it first.
+//
+// * Programmable render path
+//   The built-in shader and its vertex attributes stay bound
+//   between draws, they are only replaced for draws with a
+//   shader of the user, and its uniforms are only updated
+//   when the combined view and transform or the texture size
+//   change. The vertices are appended to a ring in a stream
+//   buffer, which is only orphaned when it is full, so
+//   uploading them never waits for the GPU to finish the
+//   previous draws and doesn't reallocate on every draw.
+//
 ////////////////////////////////////////////////////////////
@@ -89,7 +89,7 @@ bool RenderTexture::create(unsigned int width, unsigned int height, const Contex
         return false;
 
     // We can now initialize the render target part
-    RenderTarget::initialize();
+    RenderTarget::initialize((settings.attributeFlags & ContextSettings::Programmable) != 0);
 
     return true;
 }
@@ -147,6 +147,10 @@ bool RenderTexture::generateMipmap()
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
+    // Batched draws must reach the texture before its context is released
+    if (!active)
+        flush();
+
     bool result = m_impl && m_impl->activate(active);
 
     // Update RenderTarget tracking
@@ -160,6 +164,8 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    flush();
+
     // Update the target texture
     if (m_impl && (priv::RenderTextureImplFBO::isAvailable() || setActive(true)))
     {
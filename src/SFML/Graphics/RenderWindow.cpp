@@ -29,8 +29,32 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
+#include <algorithm>
 
 
+namespace
+{
+    // Number of previous frames remembered to repair reused back buffers
+    const std::size_t maxBufferAge = 4;
+
+    // Smallest rectangle containing both rectangles (an empty one is ignored)
+    sf::IntRect merge(const sf::IntRect& a, const sf::IntRect& b)
+    {
+        if ((a.width <= 0) || (a.height <= 0))
+            return b;
+
+        if ((b.width <= 0) || (b.height <= 0))
+            return a;
+
+        int left   = std::min(a.left, b.left);
+        int top    = std::min(a.top, b.top);
+        int right  = std::max(a.left + a.width, b.left + b.width);
+        int bottom = std::max(a.top + a.height, b.top + b.height);
+
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+}
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -76,6 +100,10 @@ Vector2u RenderWindow::getSize() const
 ////////////////////////////////////////////////////////////
 bool RenderWindow::setActive(bool active)
 {
+    // Batched draws must reach the window before its context is released
+    if (!active)
+        flush();
+
     bool result = Window::setActive(active);
 
     // Update RenderTarget tracking
@@ -98,6 +126,9 @@ bool RenderWindow::setActive(bool active)
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // Draws still in the batch are part of the contents
+    const_cast<RenderWindow*>(this)->flush();
+
     Vector2u windowSize = getSize();
 
     Texture texture;
@@ -108,6 +139,43 @@ Image RenderWindow::capture() const
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderWindow::addDirtyRect(const IntRect& rect)
+{
+    Vector2u size = getSize();
+    IntRect window(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+
+    IntRect dirty;
+    if (!rect.intersects(window, dirty))
+        return;
+
+    if (m_dirtyRects.empty())
+    {
+        // The back buffer still shows the frame drawn (age) frames ago:
+        // everything that changed since then must be redrawn as well
+        unsigned int age = getBufferAge();
+
+        if ((age == 0) || (age - 1 > m_damageHistory.size()))
+        {
+            m_redrawRegion = window;
+        }
+        else
+        {
+            m_redrawRegion = IntRect();
+            for (unsigned int i = 0; i + 1 < age; ++i)
+                m_redrawRegion = merge(m_redrawRegion, m_damageHistory[i]);
+        }
+    }
+
+    m_dirtyRects.push_back(dirty);
+    m_redrawRegion = merge(m_redrawRegion, dirty);
+
+    // Only applied when the window is drawn to, so that render
+    // textures drawn in its context are not clipped
+    setScissor(m_redrawRegion);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
@@ -119,7 +187,7 @@ void RenderWindow::onCreate()
     }
 
     // Just initialize the render target part
-    RenderTarget::initialize();
+    RenderTarget::initialize((getSettings().attributeFlags & ContextSettings::Programmable) != 0);
 }
 
 
@@ -128,6 +196,49 @@ void RenderWindow::onResize()
 {
     // Update the current view (recompute the viewport, which is stored in relative coordinates)
     setView(getView());
+
+    // The content of the back buffers doesn't match the history anymore
+    m_damageHistory.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    flush();
+
+    Vector2u size = getSize();
+
+    if (m_dirtyRects.empty())
+    {
+        // The whole window has been redrawn
+        m_damageHistory.push_front(IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)));
+    }
+    else
+    {
+        std::vector<Int32> rects;
+        rects.reserve(m_dirtyRects.size() * 4);
+
+        IntRect bounds;
+        for (std::vector<IntRect>::const_iterator it = m_dirtyRects.begin(); it != m_dirtyRects.end(); ++it)
+        {
+            rects.push_back(it->left);
+            rects.push_back(it->top);
+            rects.push_back(it->width);
+            rects.push_back(it->height);
+
+            bounds = merge(bounds, *it);
+        }
+
+        setDamage(&rects[0], static_cast<unsigned int>(m_dirtyRects.size()));
+        m_damageHistory.push_front(bounds);
+        m_dirtyRects.clear();
+
+        setScissor(IntRect());
+    }
+
+    if (m_damageHistory.size() > maxBufferAge)
+        m_damageHistory.pop_back();
 }
 
 } // namespace sf
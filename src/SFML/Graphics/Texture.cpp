@@ -53,6 +53,26 @@ namespace
 
         return id++;
     }
+
+    // EGL_EXT_image_dma_buf_import definitions, so that sfml-graphics doesn't
+    // depend on the EGL headers (the functions are queried at runtime)
+    typedef void* EglDisplay;
+    typedef void* EglImage;
+    typedef EglDisplay (*EglGetCurrentDisplayProc)();
+    typedef EglImage (*EglCreateImageProc)(EglDisplay, void*, unsigned int, void*, const sf::Int32*);
+    typedef unsigned int (*EglDestroyImageProc)(EglDisplay, EglImage);
+    typedef void (*EglImageTargetTexture2DProc)(GLenum, EglImage);
+
+    const sf::Int32  eglNone                 = 0x3038;
+    const sf::Int32  eglWidth                = 0x3057;
+    const sf::Int32  eglHeight               = 0x3056;
+    const unsigned int eglLinuxDmaBuf        = 0x3270;
+    const sf::Int32  eglLinuxDrmFourcc       = 0x3271;
+    const sf::Int32  eglDmaBufPlaneFd[]      = {0x3272, 0x3275, 0x3278, 0x3440};
+    const sf::Int32  eglDmaBufPlaneOffset[]  = {0x3273, 0x3276, 0x3279, 0x3441};
+    const sf::Int32  eglDmaBufPlanePitch[]   = {0x3274, 0x3277, 0x327A, 0x3442};
+    const sf::Int32  eglDmaBufPlaneModLo[]   = {0x3443, 0x3445, 0x3447, 0x3449};
+    const sf::Int32  eglDmaBufPlaneModHi[]   = {0x3444, 0x3446, 0x3448, 0x344A};
 }
 
 
@@ -317,6 +337,127 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromDmaBuf(const DmaBuf& buffer)
+{
+    // Check if the buffer description is valid before importing it
+    if ((buffer.width == 0) || (buffer.height == 0) || (buffer.planeCount == 0) || (buffer.planeCount > DmaBuf::MaxPlanes))
+    {
+        err() << "Failed to import dma-buf, invalid size (" << buffer.width << "x" << buffer.height
+              << ") or plane count (" << buffer.planeCount << ")" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    EglGetCurrentDisplayProc eglGetCurrentDisplay = reinterpret_cast<EglGetCurrentDisplayProc>(Context::getFunction("eglGetCurrentDisplay"));
+    EglCreateImageProc eglCreateImage = reinterpret_cast<EglCreateImageProc>(Context::getFunction("eglCreateImageKHR"));
+    EglDestroyImageProc eglDestroyImage = reinterpret_cast<EglDestroyImageProc>(Context::getFunction("eglDestroyImageKHR"));
+    EglImageTargetTexture2DProc glEGLImageTargetTexture2D = reinterpret_cast<EglImageTargetTexture2DProc>(Context::getFunction("glEGLImageTargetTexture2DOES"));
+
+    EglDisplay display = eglGetCurrentDisplay ? eglGetCurrentDisplay() : NULL;
+
+    if (!display || !eglCreateImage || !eglDestroyImage || !glEGLImageTargetTexture2D)
+    {
+        err() << "Failed to import dma-buf, EGL_EXT_image_dma_buf_import and OES_EGL_image are required" << std::endl;
+        return false;
+    }
+
+    // Describe the planes of the buffer
+    Int32 attributes[7 + DmaBuf::MaxPlanes * 10];
+    unsigned int count = 0;
+
+    attributes[count++] = eglWidth;
+    attributes[count++] = static_cast<Int32>(buffer.width);
+    attributes[count++] = eglHeight;
+    attributes[count++] = static_cast<Int32>(buffer.height);
+    attributes[count++] = eglLinuxDrmFourcc;
+    attributes[count++] = static_cast<Int32>(buffer.format);
+
+    for (unsigned int i = 0; i < buffer.planeCount; ++i)
+    {
+        attributes[count++] = eglDmaBufPlaneFd[i];
+        attributes[count++] = buffer.fd[i];
+        attributes[count++] = eglDmaBufPlaneOffset[i];
+        attributes[count++] = static_cast<Int32>(buffer.offset[i]);
+        attributes[count++] = eglDmaBufPlanePitch[i];
+        attributes[count++] = static_cast<Int32>(buffer.pitch[i]);
+
+        // Modifiers require EGL_EXT_image_dma_buf_import_modifiers, only pass them when there is one
+        if (buffer.modifier != DmaBuf::InvalidModifier)
+        {
+            attributes[count++] = eglDmaBufPlaneModLo[i];
+            attributes[count++] = static_cast<Int32>(buffer.modifier & 0xFFFFFFFF);
+            attributes[count++] = eglDmaBufPlaneModHi[i];
+            attributes[count++] = static_cast<Int32>(buffer.modifier >> 32);
+        }
+    }
+
+    attributes[count++] = eglNone;
+
+    EglImage image = eglCreateImage(display, NULL, eglLinuxDmaBuf, NULL, attributes);
+    if (!image)
+    {
+        err() << "Failed to import dma-buf, the driver rejected its format, layout or file descriptors" << std::endl;
+        return false;
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    static bool textureEdgeClamp = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+
+    // Clear any pending error so that we see the one of the import
+    while (glGetError() != GL_NO_ERROR) {}
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glEGLImageTargetTexture2D(GL_TEXTURE_2D, image);
+    bool imported = (glGetError() == GL_NO_ERROR);
+
+    // The texture keeps a reference to the buffer, the image isn't needed anymore
+    eglDestroyImage(display, image);
+
+    if (!imported)
+    {
+        #ifndef SFML_OPENGL_ES
+            err() << "Failed to import dma-buf, the driver can't sample its format from a 2D texture "
+                  << "(import YUV planes separately as single-channel images)" << std::endl;
+        #else
+            err() << "Failed to import dma-buf, the driver can't sample its format from a 2D texture "
+                  << "(multi-planar YUV can't be displayed with OpenGL ES, use a packed RGB format)" << std::endl;
+        #endif
+        return false;
+    }
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    // The storage has exactly the size of the buffer, it can't be padded
+    m_size.x        = buffer.width;
+    m_size.y        = buffer.height;
+    m_actualSize    = m_size;
+    m_pixelsFlipped = false;
+    m_fboAttachment = false;
+    m_hasMipmap     = false;
+    m_cacheId       = getUniqueId();
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -32,6 +32,7 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 
 namespace
@@ -56,6 +57,7 @@ namespace sf
 VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
+m_streamOffset (0),
 m_primitiveType(Points),
 m_usage        (Stream)
 {
@@ -66,6 +68,7 @@ m_usage        (Stream)
 VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
+m_streamOffset (0),
 m_primitiveType(type),
 m_usage        (Stream)
 {
@@ -76,6 +79,7 @@ m_usage        (Stream)
 VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
+m_streamOffset (0),
 m_primitiveType(Points),
 m_usage        (usage)
 {
@@ -86,6 +90,7 @@ m_usage        (usage)
 VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
+m_streamOffset (0),
 m_primitiveType(type),
 m_usage        (usage)
 {
@@ -96,6 +101,7 @@ m_usage        (usage)
 VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
+m_streamOffset (0),
 m_primitiveType(copy.m_primitiveType),
 m_usage        (copy.m_usage)
 {
@@ -147,6 +153,7 @@ bool VertexBuffer::create(std::size_t vertexCount)
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
     m_size = vertexCount;
+    m_streamOffset = 0;
 
     return true;
 }
@@ -195,6 +202,9 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
+    // Appended vertices must not overwrite these, start the ring again in new storage
+    m_streamOffset = m_size;
+
     return true;
 }
 
@@ -226,6 +236,8 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
 
+        m_streamOffset = m_size;
+
         return true;
     }
 
@@ -252,6 +264,8 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
+    m_streamOffset = m_size;
+
     if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
         return false;
 
@@ -261,6 +275,74 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 }
 
 
+////////////////////////////////////////////////////////////
+bool VertexBuffer::append(const Vertex* vertices, std::size_t vertexCount, std::size_t& offset)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (!vertices || !vertexCount)
+        return false;
+
+    TransientContextLock contextLock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Orphan the buffer when the ring is full, the GPU keeps reading
+    // the previous storage while we write to the new one
+    if (m_streamOffset + vertexCount > m_size)
+    {
+        if (vertexCount > m_size)
+            m_size = std::max(vertexCount, m_size * 2);
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_size, 0, usageToGlEnum(m_usage)));
+
+        m_streamOffset = 0;
+    }
+
+    offset = m_streamOffset;
+    m_streamOffset += vertexCount;
+
+    bool result = true;
+    bool written = false;
+
+#ifndef SFML_OPENGL_ES
+
+    // Make sure that extensions are initialized
+    sf::priv::ensureExtensionsInit();
+
+    if (GLEXT_map_buffer_range)
+    {
+        // Nothing was written to this region since the storage was allocated,
+        // so no pending draw reads it and it can be mapped without synchronizing
+        void* destination = 0;
+        glCheck(destination = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * offset, sizeof(Vertex) * vertexCount,
+                                                     GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_RANGE_BIT | GLEXT_GL_MAP_UNSYNCHRONIZED_BIT));
+
+        if (destination)
+        {
+            std::memcpy(destination, vertices, sizeof(Vertex) * vertexCount);
+
+            GLboolean unmapResult = GL_FALSE;
+            glCheck(unmapResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+
+            result = (unmapResult != GL_FALSE);
+            written = true;
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    if (!written)
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * offset, sizeof(Vertex) * vertexCount, vertices));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    return result;
+}
+
+
 ////////////////////////////////////////////////////////////
 VertexBuffer& VertexBuffer::operator =(const VertexBuffer& right)
 {
@@ -277,6 +359,7 @@ void VertexBuffer::swap(VertexBuffer& right)
 {
     std::swap(m_size,          right.m_size);
     std::swap(m_buffer,        right.m_buffer);
+    std::swap(m_streamOffset,  right.m_streamOffset);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
 }
@@ -620,6 +620,44 @@ int GlContext::evaluateFormat(unsigned int bitsPerPixel, const ContextSettings&
 }
 
 
+////////////////////////////////////////////////////////////
+FrameTiming GlContext::getFrameTiming() const
+{
+    // No timing information by default
+    return FrameTiming();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::sleepUntil(Time /*time*/)
+{
+    // The time base of the frame timing is unknown by default
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::isVerticalSyncActive() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::setDamage(const Int32* /*rects*/, unsigned int /*count*/)
+{
+    // The whole surface is presented by default
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GlContext::getBufferAge() const
+{
+    // Content of the back buffer is undefined by default
+    return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 void GlContext::cleanupUnsharedResources()
 {
@@ -712,6 +750,10 @@ void GlContext::initialize(const ContextSettings& requestedSettings)
 
     m_settings.attributeFlags = ContextSettings::Default;
 
+    // The programmable attribute is only read by the graphics module, keep it as requested
+    if (requestedSettings.attributeFlags & ContextSettings::Programmable)
+        m_settings.attributeFlags |= ContextSettings::Programmable;
+
     if (m_settings.majorVersion >= 3)
     {
         // Retrieve the context flags
@@ -31,6 +31,7 @@
 #include <SFML/Config.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/ContextSettings.hpp>
+#include <SFML/Window/FrameTiming.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/System/NonCopyable.hpp>
 
@@ -221,6 +222,71 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing of the last frame presented on screen
+    ///
+    /// The default implementation reports no timing information.
+    ///
+    /// \return Timing of the last presented frame
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual FrameTiming getFrameTiming() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sleep until the given time
+    ///
+    /// The time is given in the time base of the FrameTiming
+    /// values, so that a frame can be started at a precise
+    /// point of the refresh cycle. The default implementation
+    /// doesn't know this time base and returns immediately.
+    ///
+    /// \param time Time to wake up at
+    ///
+    /// \return True if the context waited, false if not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool sleepUntil(Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the frames are shown at vertical blanks
+    ///
+    /// Used with the timing of getFrameTiming() to pace the
+    /// frames: synchronized frames are already paced by the
+    /// display. The default implementation returns false.
+    ///
+    /// \return True if display() presents at vertical blanks
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool isVerticalSyncActive() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the regions that changed in the frame
+    ///        presented by the next call to display()
+    ///
+    /// Rectangles are given as (left, top, width, height)
+    /// quadruples in window coordinates. The damage is reset
+    /// by display(). The default implementation ignores it
+    /// and always presents the whole surface.
+    ///
+    /// \param rects Array of 4 * \a count integers
+    /// \param count Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setDamage(const Int32* rects, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer
+    ///
+    /// The age is the number of frames since the back buffer
+    /// was last presented, so that only the regions damaged
+    /// since then need to be redrawn into it. The default
+    /// implementation returns 0 (content undefined).
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBufferAge() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #include <SFML/Config.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 #include <algorithm>
 
 
@@ -71,6 +72,7 @@ struct JoystickState
     bool  connected;                      ///< Is the joystick currently connected?
     float axes[Joystick::AxisCount];      ///< Position of each axis, in range [-100, 100]
     bool  buttons[Joystick::ButtonCount]; ///< Status of each button (true = pressed)
+    Time  timestamp;                      ///< Time of the last change, in the time base of sf::Clock (zero if unknown)
 };
 
 } // namespace priv
@@ -64,6 +64,12 @@ const Joystick::Identification& JoystickManager::getIdentification(unsigned int
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
 {
+#if defined(SFML_SYSTEM_LINUX)
+    // Don't query every joystick slot when none of them has anything to report
+    if (!JoystickImpl::hasPendingEvents())
+        return;
+#endif
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         Item& item = m_joysticks[i];
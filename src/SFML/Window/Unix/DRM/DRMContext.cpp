@@ -34,6 +34,8 @@
 #include <SFML/Window/Unix/DRM/drm-common.h>
 #include <SFML/OpenGL.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Sleep.hpp>
 
 #include <unistd.h>
@@ -41,6 +43,10 @@
 #include <cstdlib>
 #include <errno.h>
 #include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
 
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
@@ -59,51 +65,260 @@ EGLAPI EGLSurface EGLAPIENTRY eglCreatePlatformPixmapSurfaceEXT (EGLDisplay dpy,
 #endif
 #endif // EGL_EXT_platform_base
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
 namespace
 {
     PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = NULL;
     PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC eglCreatePlatformWindowSurfaceEXT = NULL;
     static bool initialized = false;
-    static struct drm my_drm;
+    static bool headless = false; // no DRM device, render into pbuffers
+
+    // A connector with the crtc driving it. The first one is opened by
+    // check_init() and owns the device, the others are set up on demand
+    // when windows are created on them.
+    struct output
+    {
+        struct drm drm;
+        unsigned int windows;   // number of windows shown on the output
+        bool modeset_done;
+        std::vector<sf::priv::DRMContext *> staged_contexts;    // waiting for the next atomic commit
+        std::vector<sf::priv::DRMContext *> committed_contexts; // updated by the atomic commit in flight
+    };
+
+    static output outputs[MAX_OUTPUTS];
+    static unsigned int output_count = 0;
+    static struct drm &my_drm = outputs[0].drm;
+    static drmModeModeInfo *desktop_mode = NULL; // mode of the primary output when it was opened
     static drmEventContext my_evctx;
     static pollfd my_fds;
     static struct gbm_device *my_gbm_device = NULL;
     static int context_count = 0;
     static EGLDisplay display = EGL_NO_DISPLAY;
-    static int waiting_for_flip = 0;
+    static bool triple_buffer = false;
+    static bool low_latency = false;           // does disabling vsync stop display() from waiting for vblank?
+    static bool async_flip = false;            // tear instead of waiting for vblank when vsync is disabled
+    static bool monotonic_timestamps = true;
+    static bool delivering_flips = false;
+    static pthread_t display_thread;           // last thread to present a frame
+    static bool display_thread_known = false;
+    static struct gbm_bo *cursor_bo = NULL;
+    static sf::Vector2u cursor_hotspot;
+    static sf::Vector2i cursor_position;
+    static bool cursor_visible = true;
+    static bool cursor_shown = false;          // is the cursor image set on the crtc?
+    static sf::Mutex cursor_mutex;             // the cursor is moved from the input thread
+
+    typedef EGLBoolean (EGLAPIENTRYP SwapBuffersWithDamageProc)(EGLDisplay dpy, EGLSurface surface, EGLint *rects, EGLint n_rects);
+    static SwapBuffersWithDamageProc swap_buffers_with_damage = NULL; // EGL_KHR/EXT_swap_buffers_with_damage
+    static bool buffer_age = false;                                   // EGL_EXT_buffer_age
+
+    // Layout of struct drm_mode_rect, which older libdrm headers lack
+    struct damage_clip
+    {
+        int32_t x1, y1, x2, y2;
+    };
+
+    // Current time in the time base used by sf::Clock
+    sf::Time monotonic_time()
+    {
+        timespec time;
+        clock_gettime( CLOCK_MONOTONIC, &time );
+        return sf::microseconds( static_cast<sf::Int64>( time.tv_sec ) * 1000000 + time.tv_nsec / 1000 );
+    }
+
+    // Current time in the time base used by gettimeofday()
+    sf::Time realtime_time()
+    {
+        timespec time;
+        clock_gettime( CLOCK_REALTIME, &time );
+        return sf::microseconds( static_cast<sf::Int64>( time.tv_sec ) * 1000000 + time.tv_nsec / 1000 );
+    }
+
+    //
+    // Show, hide or move the hardware cursor to match the current state.
+    // The legacy cursor ioctls are used even with atomic modesetting so that
+    // cursor moves never have to wait for a pending commit.
+    //
+    static void update_cursor()
+    {
+        sf::Lock lock( cursor_mutex );
+
+        if ( !outputs[0].modeset_done )
+            return; // applied once the crtc of the primary output is running
+
+        cursor_shown = false;
+
+        if ( !cursor_bo || !cursor_visible )
+        {
+            drmModeSetCursor( my_drm.fd, my_drm.crtc_id, 0, 0, 0 );
+            return;
+        }
+
+        uint32_t handle = gbm_bo_get_handle( cursor_bo ).u32;
+        uint32_t width = gbm_bo_get_width( cursor_bo );
+        uint32_t height = gbm_bo_get_height( cursor_bo );
+
+        if ( drmModeSetCursor2( my_drm.fd, my_drm.crtc_id, handle, width, height,
+                cursor_hotspot.x, cursor_hotspot.y )
+            && drmModeSetCursor( my_drm.fd, my_drm.crtc_id, handle, width, height ))
+        {
+            sf::err() << "Failed to set hardware cursor: " << strerror(errno) << std::endl;
+            return;
+        }
+
+        drmModeMoveCursor( my_drm.fd, my_drm.crtc_id,
+            cursor_position.x - static_cast<int>( cursor_hotspot.x ),
+            cursor_position.y - static_cast<int>( cursor_hotspot.y ));
+
+        cursor_shown = true;
+    }
+
+    //
+    // Commit the planes of all the staged contexts of an output at once. Only
+    // one atomic commit per crtc can be in flight, contexts staged meanwhile
+    // go with the next one.
+    //
+    static bool atomic_commit( output &out )
+    {
+        if ( out.staged_contexts.empty() )
+            return true;
+
+        drmModeAtomicReq *req = drmModeAtomicAlloc();
+        uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
+
+        if ( !out.modeset_done )
+        {
+            flags |= DRM_MODE_ATOMIC_ALLOW_MODESET;
+            drm_add_connector_property( &out.drm, req, "CRTC_ID", out.drm.crtc_id );
+            drm_add_crtc_property( &out.drm, req, "MODE_ID", out.drm.mode_blob_id );
+            drm_add_crtc_property( &out.drm, req, "ACTIVE", 1 );
+        }
+
+        bool ok = true;
+        for ( std::vector<sf::priv::DRMContext *>::iterator itr = out.staged_contexts.begin(); itr != out.staged_contexts.end(); ++itr )
+            ok = ok && (*itr)->addPlaneProperties( req );
+
+        out.committed_contexts.swap( out.staged_contexts );
+        out.staged_contexts.clear();
+
+        if ( !ok || drmModeAtomicCommit( out.drm.fd, req, flags, &out.committed_contexts ))
+        {
+            sf::err() << "Failed to commit atomic page flip: " << strerror(errno) << std::endl;
+
+            std::vector<sf::priv::DRMContext *> contexts;
+            contexts.swap( out.committed_contexts );
+            for ( std::vector<sf::priv::DRMContext *>::iterator itr = contexts.begin(); itr != contexts.end(); ++itr )
+                (*itr)->flipFailed();
+
+            drmModeAtomicFree( req );
+            return false;
+        }
+
+        drmModeAtomicFree( req );
+
+        if ( !out.modeset_done )
+        {
+            out.modeset_done = true;
+            update_cursor();
+        }
+
+        return true;
+    }
 
     static void page_flip_handler(int fd, unsigned int frame,
         unsigned int sec, unsigned int usec, void *data)
     {
         // suppress unused param warning
-        (void)fd, (void)frame, (void)sec, (void)usec;
+        (void)fd;
 
-        int *waiting_for_flip = (int *)data;
-        *waiting_for_flip = 0;
-    }
+        sf::Time timestamp = sf::microseconds( static_cast<sf::Int64>( sec ) * 1000000 + usec );
 
-    static bool wait_for_flip(int timeout)
-    {
-        while ( waiting_for_flip )
+        for ( unsigned int i = 0; i < output_count; ++i )
         {
-            my_fds.revents = 0;
+            output &out = outputs[i];
+            if ( data != &out.committed_contexts )
+                continue;
 
-            if ( poll( &my_fds, 1, timeout ) < 0 )
-                return false;
+            // An atomic commit completes all the planes it updated at once
+            std::vector<sf::priv::DRMContext *> contexts;
+            contexts.swap( out.committed_contexts );
 
-            if ( my_fds.revents & ( POLLHUP | POLLERR ))
-                return false;
+            delivering_flips = true;
+            for ( std::vector<sf::priv::DRMContext *>::iterator itr = contexts.begin(); itr != contexts.end(); ++itr )
+                (*itr)->pageFlipped( frame, timestamp );
+            delivering_flips = false;
 
-            if ( my_fds.revents & POLLIN )
-            {
-                drmHandleEvent( my_drm.fd, &my_evctx );
-            }
-            else
+            atomic_commit( out );
+            return;
+        }
+
+        sf::priv::DRMContext *context = static_cast<sf::priv::DRMContext *>( data );
+        context->pageFlipped( frame, timestamp );
+    }
+
+    //
+    // Planes that can be used on several crtcs appear in the plane list of
+    // each of their outputs: mark them everywhere.
+    //
+    static void mark_plane( uint32_t plane_id, int in_use )
+    {
+        for ( unsigned int i = 0; i < output_count; ++i )
+        {
+            struct drm &drm = outputs[i].drm;
+            for ( int j = 0; j < drm.count_planes; ++j )
             {
-                return false;
+                if ( drm.planes[j].plane->plane_id == plane_id )
+                    drm.planes[j].in_use = in_use;
             }
         }
-        return true;
+    }
+
+    static struct plane *take_plane( struct drm *drm, uint64_t type )
+    {
+        struct plane *plane = drm_get_plane( drm, type );
+
+        if ( plane )
+            mark_plane( plane->plane->plane_id, 1 );
+
+        return plane;
+    }
+
+    static void release_plane( struct plane *plane )
+    {
+        drm_put_plane( plane );
+
+        if ( plane )
+            mark_plane( plane->plane->plane_id, 0 );
+    }
+
+    //
+    // Wait up to timeout milliseconds (-1 to wait forever) for the drm fd to
+    // become readable and dispatch the pending events to their handlers.
+    //
+    static bool dispatch_drm_events(int timeout)
+    {
+        my_fds.revents = 0;
+
+        if ( poll( &my_fds, 1, timeout ) < 0 )
+            return false;
+
+        if ( my_fds.revents & ( POLLHUP | POLLERR ))
+            return false;
+
+        if ( my_fds.revents & POLLIN )
+        {
+            drmHandleEvent( my_drm.fd, &my_evctx );
+            return true;
+        }
+
+        return false;
     }
 
     void cleanup()
@@ -111,35 +326,66 @@ namespace
         if ( !initialized )
             return;
 
-        drmModeSetCrtc( my_drm.fd,
-            my_drm.original_crtc->crtc_id,
-            my_drm.original_crtc->buffer_id,
-            my_drm.original_crtc->x,
-            my_drm.original_crtc->y,
-            &my_drm.connector_id,
-            1,
-            &my_drm.original_crtc->mode );
+        {
+            sf::Lock lock( cursor_mutex );
 
-        drmModeFreeConnector( my_drm.saved_connector );
-        drmModeFreeEncoder( my_drm.saved_encoder );
-        drmModeFreeCrtc( my_drm.original_crtc );
+            if ( cursor_bo )
+            {
+                drmModeSetCursor( my_drm.fd, my_drm.crtc_id, 0, 0, 0 );
+                gbm_bo_destroy( cursor_bo );
+                cursor_bo = NULL;
+            }
+
+            cursor_shown = false;
+        }
+
+        for ( unsigned int i = 0; i < output_count; ++i )
+        {
+            struct drm &drm = outputs[i].drm;
+
+            if ( drm.original_crtc )
+            {
+                drmModeSetCrtc( drm.fd,
+                    drm.original_crtc->crtc_id,
+                    drm.original_crtc->buffer_id,
+                    drm.original_crtc->x,
+                    drm.original_crtc->y,
+                    &drm.connector_id,
+                    1,
+                    &drm.original_crtc->mode );
+            }
+
+            free_drm_atomic( &drm );
+
+            drmModeFreeConnector( drm.saved_connector );
+            drmModeFreeEncoder( drm.saved_encoder );
+            drmModeFreeCrtc( drm.original_crtc );
+
+            outputs[i].windows = 0;
+            outputs[i].modeset_done = false;
+        }
 
         eglTerminate( display );
         display = EGL_NO_DISPLAY;
 
-        gbm_device_destroy( my_gbm_device );
+        if ( my_gbm_device )
+            gbm_device_destroy( my_gbm_device );
         my_gbm_device = NULL;
 
-        close( my_drm.fd );
+        if ( my_drm.fd >= 0 )
+            close( my_drm.fd );
+
+        for ( unsigned int i = 0; i < output_count; ++i )
+            memset( &outputs[i].drm, 0, sizeof( struct drm ));
 
+        output_count = 0;
         my_drm.fd = -1;
-        my_drm.mode = 0;
+        desktop_mode = NULL;
 
         memset(&my_fds,     0, sizeof(struct pollfd));
         memset(&my_evctx,   0, sizeof(drmEventContext));
 
-        waiting_for_flip = 0;
-
+        headless = false;
         initialized = false;
     }
 
@@ -165,17 +411,69 @@ namespace
 		if (refresh_str)
 			vrefresh = atoi(refresh_str);
 
-        if ( init_drm( &my_drm,
+        // triple buffering: Use environment variable "SFML_DRM_TRIPLE_BUFFER" (disabled if not set)
+        // lets display() return while a page flip is still pending
+        triple_buffer = ( getenv( "SFML_DRM_TRIPLE_BUFFER" ) != NULL );
+
+        // present mode: Use environment variable "SFML_DRM_PRESENT_MODE" (always vsynced flips if not set)
+        // "async" tears and "mailbox" shows the newest frame at the next vblank when vsync is disabled.
+        // It is opt-in because every window starts with vsync disabled
+        const char *present_mode = getenv( "SFML_DRM_PRESENT_MODE" );
+        if ( present_mode && ( strcmp( present_mode, "async" ) != 0 ) && ( strcmp( present_mode, "mailbox" ) != 0 ))
+        {
+            sf::err() << "Unknown SFML_DRM_PRESENT_MODE " << present_mode << ", using vsynced flips" << std::endl;
+            present_mode = NULL;
+        }
+        low_latency = ( present_mode != NULL );
+
+        // headless: Use environment variable "SFML_DRM_HEADLESS" (use the drm device if not set)
+        // renders into EGL pbuffers without any display or GPU, e.g. with Mesa's llvmpipe on build servers
+        headless = ( getenv( "SFML_DRM_HEADLESS" ) != NULL );
+
+        if ( !headless && ( init_drm( &my_drm,
             device_str,          // device
             mode_str,            // requested mode
-            vrefresh ) < 0 )     // vrefresh
+            vrefresh ) < 0 ))    // vrefresh
+        {
+            sf::err() << "Error initializing drm, falling back to headless rendering" << std::endl;
+
+            if ( my_drm.fd >= 0 )
+                close( my_drm.fd );
+
+            memset( &my_drm, 0, sizeof( struct drm ));
+            headless = true;
+        }
+
+        if ( headless )
         {
-            sf::err() << "Error initializing drm" << std::endl;
+            my_drm.fd = -1;
+
+            std::atexit( cleanup );
+            initialized = true;
             return;
         }
 
+        output_count = 1;
+        desktop_mode = my_drm.mode;
+
+        // Very old kernels report event timestamps with gettimeofday()
+        uint64_t cap = 0;
+        monotonic_timestamps = ( drmGetCap( my_drm.fd, DRM_CAP_TIMESTAMP_MONOTONIC, &cap ) == 0 ) && cap;
+
+        // Without async flips, the async mode falls back to the mailbox behaviour
+        cap = 0;
+        async_flip = present_mode && ( strcmp( present_mode, "async" ) == 0 )
+            && ( drmGetCap( my_drm.fd, DRM_CAP_ASYNC_PAGE_FLIP, &cap ) == 0 ) && cap;
+        if ( low_latency && !async_flip && ( strcmp( present_mode, "async" ) == 0 ))
+            sf::err() << "Async page flips not supported, using the mailbox present mode" << std::endl;
+
         my_gbm_device = gbm_create_device( my_drm.fd );
 
+        // atomic: Use environment variable "SFML_DRM_ATOMIC" (legacy modesetting if not set)
+        // required to show Style::Overlay windows on hardware overlay planes
+        if ( getenv( "SFML_DRM_ATOMIC" ) && ( init_drm_atomic( &my_drm ) < 0 ))
+            sf::err() << "Atomic modesetting not available, using legacy modesetting" << std::endl;
+
         std::atexit( cleanup );
         initialized = true;
 
@@ -207,6 +505,19 @@ namespace
     }
 
 
+    // The programmable render path of the graphics module needs an OpenGL ES 2
+    // context, desktop OpenGL contexts have both render paths
+    bool isProgrammable( const sf::ContextSettings& settings )
+    {
+#if defined(SFML_OPENGL_ES)
+        return ( settings.attributeFlags & sf::ContextSettings::Programmable ) != 0;
+#else
+        (void)settings;
+        return false;
+#endif
+    }
+
+
     EGLDisplay getInitializedDisplay()
     {
         check_init();
@@ -223,7 +534,8 @@ namespace
                 eglCreatePlatformWindowSurfaceEXT = (PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC)eglGetProcAddress(
                     "eglCreatePlatformWindowSurfaceEXT");
 
-                if ((!has_ext(egl_exts_client, "EGL_MESA_platform_gbm"))
+                if (!headless
+                       && (!has_ext(egl_exts_client, "EGL_MESA_platform_gbm"))
                        && (!has_ext(egl_exts_client, "EGL_KHR_platform_gbm")))
                 {
                     sf::err() << "Couldn't find required EGL extension: EGL_MESA_platform_gbm or EGL_KHR_platform_gbm" << std::endl;
@@ -233,7 +545,15 @@ namespace
             else
                 sf::err() << "EGL_EXT_platform_base extension not found!" << std::endl;
 
-            if (eglGetPlatformDisplayEXT)
+            if (headless)
+            {
+                // Mesa can render without any window system or device
+                if (eglGetPlatformDisplayEXT && has_ext(egl_exts_client, "EGL_MESA_platform_surfaceless"))
+                    display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+                else
+                    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            }
+            else if (eglGetPlatformDisplayEXT)
                 // EGL_PLATFORM_GBM_KHR and EGL_PLATFORM_GBM_MESA are equal
                 display = eglGetPlatformDisplayEXT(EGL_PLATFORM_GBM_KHR, my_gbm_device, NULL);
             else
@@ -244,6 +564,18 @@ namespace
             EGLint major, minor;
             eglCheck(eglInitialize(display, &major, &minor));
 
+            // Partial presentation of damaged regions
+            const char *egl_exts_display = eglQueryString(display, EGL_EXTENSIONS);
+
+            if (has_ext(egl_exts_display, "EGL_KHR_swap_buffers_with_damage"))
+                swap_buffers_with_damage = (SwapBuffersWithDamageProc)eglGetProcAddress(
+                    "eglSwapBuffersWithDamageKHR");
+            else if (has_ext(egl_exts_display, "EGL_EXT_swap_buffers_with_damage"))
+                swap_buffers_with_damage = (SwapBuffersWithDamageProc)eglGetProcAddress(
+                    "eglSwapBuffersWithDamageEXT");
+
+            buffer_age = has_ext(egl_exts_display, "EGL_EXT_buffer_age");
+
 #if defined(SFML_OPENGL_ES)
             if ( !eglBindAPI( EGL_OPENGL_ES_API ) )
             {
@@ -274,11 +606,24 @@ m_surface (EGL_NO_SURFACE),
 m_config  (NULL),
 m_cur_bo (NULL),
 m_next_bo (NULL),
+m_queued_bo (NULL),
 m_gbm_surface (NULL),
 m_width   (0),
 m_height  (0),
 m_shown   (false),
-m_scanout (false)
+m_scanout (false),
+m_waitingForFlip (false),
+m_verticalSync (true),
+m_frameCount (0),
+m_lateFrames (0),
+m_droppedFrames (0),
+m_vblankCount (0),
+m_presentTime (Time::Zero),
+m_owner (NULL),
+m_plane (NULL),
+m_next_damage (0),
+m_queued_damage (0),
+m_output (0)
 {
     context_count++;
 
@@ -290,7 +635,7 @@ m_scanout (false)
     updateSettings();
 
     // Create EGL context
-    createContext(shared);
+    createContext(shared, ContextSettings());
 
     if ( shared )
         createSurface( shared->m_width, shared->m_height, VideoMode::getDesktopMode().bitsPerPixel, false );
@@ -307,11 +652,24 @@ m_surface (EGL_NO_SURFACE),
 m_config  (NULL),
 m_cur_bo (NULL),
 m_next_bo (NULL),
+m_queued_bo (NULL),
 m_gbm_surface (NULL),
 m_width   (0),
 m_height  (0),
 m_shown   (false),
-m_scanout (false)
+m_scanout (false),
+m_waitingForFlip (false),
+m_verticalSync (true),
+m_frameCount (0),
+m_lateFrames (0),
+m_droppedFrames (0),
+m_vblankCount (0),
+m_presentTime (Time::Zero),
+m_owner (NULL),
+m_plane (NULL),
+m_next_damage (0),
+m_queued_damage (0),
+m_output (0)
 {
     context_count++;
 
@@ -323,10 +681,13 @@ m_scanout (false)
     updateSettings();
 
     // Create EGL context
-    createContext(shared);
+    createContext(shared, settings);
 
     if ( owner )
     {
+        m_owner = static_cast<const WindowImplDRM *>( owner );
+        m_output = m_owner->getOutput();
+
         Vector2u s = owner->getSize();
         createSurface( s.x, s.y, bitsPerPixel, true );
     }
@@ -341,11 +702,24 @@ m_surface (EGL_NO_SURFACE),
 m_config  (NULL),
 m_cur_bo (NULL),
 m_next_bo (NULL),
+m_queued_bo (NULL),
 m_gbm_surface (NULL),
 m_width   (0),
 m_height  (0),
 m_shown   (false),
-m_scanout (false)
+m_scanout (false),
+m_waitingForFlip (false),
+m_verticalSync (true),
+m_frameCount (0),
+m_lateFrames (0),
+m_droppedFrames (0),
+m_vblankCount (0),
+m_presentTime (Time::Zero),
+m_owner (NULL),
+m_plane (NULL),
+m_next_damage (0),
+m_queued_damage (0),
+m_output (0)
 {
     context_count++;
 
@@ -357,7 +731,7 @@ m_scanout (false)
     updateSettings();
 
     // Create EGL context
-    createContext(shared);
+    createContext(shared, settings);
     createSurface( width, height, VideoMode::getDesktopMode().bitsPerPixel, false );
 }
 
@@ -365,6 +739,49 @@ m_scanout (false)
 ////////////////////////////////////////////////////////////
 DRMContext::~DRMContext()
 {
+    // The kernel still holds a pointer to us until the pending flip is delivered
+    if ( m_queued_bo )
+    {
+        gbm_surface_release_buffer( m_gbm_surface, m_queued_bo );
+        m_queued_bo = NULL;
+    }
+
+    if ( m_queued_damage )
+    {
+        drmModeDestroyPropertyBlob( my_drm.fd, m_queued_damage );
+        m_queued_damage = 0;
+    }
+
+    waitForFlip( -1 );
+
+    std::vector<DRMContext *> &staged = outputs[m_output].staged_contexts;
+    std::vector<DRMContext *> &committed = outputs[m_output].committed_contexts;
+    staged.erase( std::remove( staged.begin(), staged.end(), this ), staged.end() );
+    committed.erase( std::remove( committed.begin(), committed.end(), this ), committed.end() );
+
+    if ( m_plane )
+    {
+        // Overlay planes show our buffers until they are turned off
+        if ( m_plane->type != DRM_PLANE_TYPE_PRIMARY )
+        {
+            drmModeAtomicReq *req = drmModeAtomicAlloc();
+            drm_add_plane_property( &my_drm, req, m_plane, "FB_ID", 0 );
+            drm_add_plane_property( &my_drm, req, m_plane, "CRTC_ID", 0 );
+            drmModeAtomicCommit( my_drm.fd, req, 0, NULL );
+            drmModeAtomicFree( req );
+        }
+
+        release_plane( m_plane );
+        m_plane = NULL;
+    }
+
+    if ( m_scanout && getenv( "SFML_DRM_DEBUG" ))
+    {
+        err() << "DRM frames presented: " << m_frameCount
+            << ", late: " << m_lateFrames
+            << ", dropped: " << m_droppedFrames << std::endl;
+    }
+
     // Deactivate the current context
     EGLContext currentContext = eglCheck(eglGetCurrentContext());
 
@@ -422,78 +839,404 @@ void DRMContext::display()
 
     if ( !m_scanout )
     {
-        eglCheck( eglSwapBuffers( m_display, m_surface ));
+        swapBuffers();
         return;
     }
 
+    display_thread = pthread_self();
+    display_thread_known = true;
+
     //
     // Handle display of buffer to the screen
     //
-    struct drm_fb *fb = NULL;
+    // Without vsync, display() never waits for the screen: a frame finished while
+    // a flip is pending replaces the one queued behind it (mailbox)
+    bool mailbox = !isVerticalSyncActive();
 
-    if ( !wait_for_flip( -1 ))
-        return;
+    if ( triple_buffer || mailbox )
+    {
+        // Collect the flips that completed since the last frame without blocking
+        if ( m_waitingForFlip )
+            dispatch_drm_events( 0 );
 
-    if ( m_cur_bo )
+        // A finished frame still queued behind the pending flip means that all
+        // three buffers (scanout, pending flip, queued) are busy: wait for scanout
+        if ( m_queued_bo && !mailbox )
+        {
+            m_lateFrames++;
+            if ( !waitForFlip( -1 ))
+                return;
+        }
+    }
+    else if ( !waitForFlip( -1 ))
     {
-        gbm_surface_release_buffer( m_gbm_surface, m_cur_bo );
-        m_cur_bo = NULL;
+        m_damage.clear();
+        return;
     }
 
-    eglCheck( eglSwapBuffers( m_display, m_surface ));
+    // Damage clips tell the display controller which parts of the plane changed
+    uint32_t damage = 0;
+    if ( m_plane && !m_damage.empty() )
+    {
+        std::vector<damage_clip> clips( m_damage.size() / 4 );
+        for ( std::size_t i = 0; i < clips.size(); ++i )
+        {
+            clips[i].x1 = m_damage[i * 4];
+            clips[i].y1 = m_damage[i * 4 + 1];
+            clips[i].x2 = m_damage[i * 4] + m_damage[i * 4 + 2];
+            clips[i].y2 = m_damage[i * 4 + 1] + m_damage[i * 4 + 3];
+        }
+
+        if ( drmModeCreatePropertyBlob( my_drm.fd, &clips[0], clips.size() * sizeof( damage_clip ), &damage ))
+            damage = 0; // whole plane
+    }
 
-    m_cur_bo = m_next_bo;
+    swapBuffers();
 
     //
     // This call must be preceeded by a single call to eglSwapBuffers()
     //
-    m_next_bo = gbm_surface_lock_front_buffer( m_gbm_surface );
+    struct gbm_bo *bo = gbm_surface_lock_front_buffer( m_gbm_surface );
 
-    if ( !m_next_bo )
+    if ( !bo )
+    {
+        if ( damage )
+            drmModeDestroyPropertyBlob( my_drm.fd, damage );
         return;
+    }
+
+    if ( m_waitingForFlip )
+    {
+        if ( m_queued_bo )
+        {
+            // The replaced frame never reaches the screen, so its damage must be
+            // shown too: update the whole plane instead
+            gbm_surface_release_buffer( m_gbm_surface, m_queued_bo );
+            m_droppedFrames++;
+
+            if ( m_queued_damage )
+                drmModeDestroyPropertyBlob( my_drm.fd, m_queued_damage );
+            if ( damage )
+                drmModeDestroyPropertyBlob( my_drm.fd, damage );
+            damage = 0;
+        }
+
+        m_queued_bo = bo; // flipped as soon as the pending flip completes
+        m_queued_damage = damage;
+    }
+    else
+        queueFlip( bo, damage );
+
+    // Make sure that there is a free buffer to render the next frame into
+    if ( m_waitingForFlip && !gbm_surface_has_free_buffers( m_gbm_surface ))
+    {
+        m_lateFrames++;
+        waitForFlip( -1 );
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::pageFlipped(unsigned int vblankCount, Time timestamp)
+{
+    m_waitingForFlip = false;
+    m_frameCount++;
+
+    m_vblankCount = vblankCount;
+    m_presentTime = monotonic_timestamps ? timestamp : timestamp - realtime_time() + monotonic_time();
+
+    // The buffer that was on screen until now can be reused for rendering
+    if ( m_cur_bo )
+        gbm_surface_release_buffer( m_gbm_surface, m_cur_bo );
+
+    m_cur_bo = m_next_bo;
+    m_next_bo = NULL;
+
+    if ( m_next_damage )
+    {
+        drmModeDestroyPropertyBlob( my_drm.fd, m_next_damage );
+        m_next_damage = 0;
+    }
+
+    if ( m_queued_bo )
+    {
+        struct gbm_bo *bo = m_queued_bo;
+        uint32_t damage = m_queued_damage;
+        m_queued_bo = NULL;
+        m_queued_damage = 0;
+
+        queueFlip( bo, damage );
+    }
+}
+
 
-    fb = drm_fb_get_from_bo( m_next_bo );
+////////////////////////////////////////////////////////////
+void DRMContext::queueFlip(struct gbm_bo *bo, uint32_t damage)
+{
+    struct drm_fb *fb = drm_fb_get_from_bo( bo );
     if ( !fb )
     {
         err() << "Failed to get FB from buffer object" << std::endl;
+        gbm_surface_release_buffer( m_gbm_surface, bo );
+        if ( damage )
+            drmModeDestroyPropertyBlob( my_drm.fd, damage );
+        m_droppedFrames++;
+        return;
+    }
+
+    if ( m_plane )
+    {
+        m_next_bo = bo;
+        m_next_damage = damage;
+        m_waitingForFlip = true;
+        output &out = outputs[m_output];
+        out.staged_contexts.push_back( this );
+
+        // Flips completing right now are committed together once all are delivered
+        if ( out.committed_contexts.empty() && !delivering_flips )
+            atomic_commit( out );
+
         return;
     }
 
+    struct drm &drm = outputs[m_output].drm;
+
     //
     // If first time, need to first call drmModeSetCrtc()
     //
     if ( !m_shown )
     {
-        if ( drmModeSetCrtc( my_drm.fd, my_drm.crtc_id, fb->fb_id, 0, 0,
-            &my_drm.connector_id, 1, my_drm.mode ))
+        if ( drmModeSetCrtc( drm.fd, drm.crtc_id, fb->fb_id, 0, 0,
+            &drm.connector_id, 1, drm.mode ))
         {
             err() << "Failed to set mode: " << strerror(errno) << std::endl;
             abort();
         }
         m_shown = true;
+
+        if ( !outputs[m_output].modeset_done )
+        {
+            outputs[m_output].modeset_done = true;
+            update_cursor();
+        }
     }
 
     //
-    // Do page flip
+    // Do page flip, right away if vsync is disabled and the driver can
+    // flip outside of vblank.  Some drivers refuse async flips that change
+    // the buffer layout, these are done at the next vblank instead
     //
-    if ( !drmModePageFlip( my_drm.fd, my_drm.crtc_id, fb->fb_id,
-            DRM_MODE_PAGE_FLIP_EVENT, &waiting_for_flip ))
-        waiting_for_flip = 1;
+    int result = -1;
+    if ( async_flip && !isVerticalSyncActive() )
+        result = drmModePageFlip( drm.fd, drm.crtc_id, fb->fb_id,
+            DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_PAGE_FLIP_ASYNC, this );
+
+    if ( result && drmModePageFlip( drm.fd, drm.crtc_id, fb->fb_id,
+            DRM_MODE_PAGE_FLIP_EVENT, this ))
+    {
+        err() << "Failed to queue page flip: " << strerror(errno) << std::endl;
+        gbm_surface_release_buffer( m_gbm_surface, bo );
+        m_droppedFrames++;
+        return;
+    }
+
+    m_next_bo = bo;
+    m_waitingForFlip = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::flipFailed()
+{
+    m_waitingForFlip = false;
+
+    if ( m_next_damage )
+    {
+        drmModeDestroyPropertyBlob( my_drm.fd, m_next_damage );
+        m_next_damage = 0;
+    }
+
+    if ( m_queued_damage )
+    {
+        drmModeDestroyPropertyBlob( my_drm.fd, m_queued_damage );
+        m_queued_damage = 0;
+    }
+
+    if ( m_next_bo )
+    {
+        gbm_surface_release_buffer( m_gbm_surface, m_next_bo );
+        m_next_bo = NULL;
+        m_droppedFrames++;
+    }
+
+    if ( m_queued_bo )
+    {
+        gbm_surface_release_buffer( m_gbm_surface, m_queued_bo );
+        m_queued_bo = NULL;
+        m_droppedFrames++;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool DRMContext::addPlaneProperties(drmModeAtomicReq *req)
+{
+    struct drm_fb *fb = drm_fb_get_from_bo( m_next_bo );
+    Vector2i position = m_owner ? m_owner->getPosition() : Vector2i( 0, 0 );
+
+    // Damage clips are optional, drivers without the property update the whole plane
+    drm_add_plane_property( &my_drm, req, m_plane, "FB_DAMAGE_CLIPS", m_next_damage );
+
+    // Source coordinates are 16.16 fixed point, destination may be off-screen
+    return ( drm_add_plane_property( &my_drm, req, m_plane, "FB_ID", fb->fb_id ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "CRTC_ID", outputs[m_output].drm.crtc_id ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "SRC_X", 0 ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "SRC_Y", 0 ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "SRC_W", static_cast<uint64_t>( m_width ) << 16 ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "SRC_H", static_cast<uint64_t>( m_height ) << 16 ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "CRTC_X", static_cast<uint64_t>( static_cast<Int64>( position.x ))) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "CRTC_Y", static_cast<uint64_t>( static_cast<Int64>( position.y ))) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "CRTC_W", m_width ) >= 0 )
+        && ( drm_add_plane_property( &my_drm, req, m_plane, "CRTC_H", m_height ) >= 0 );
+}
+
+
+////////////////////////////////////////////////////////////
+bool DRMContext::waitForFlip(int timeout)
+{
+    Uint64 frameCount = m_frameCount;
+
+    while ( m_waitingForFlip && ( m_frameCount == frameCount ))
+    {
+        if ( !dispatch_drm_events( timeout ))
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::setDamage(const Int32* rects, unsigned int count)
+{
+    m_damage.insert( m_damage.end(), rects, rects + count * 4 );
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int DRMContext::getBufferAge() const
+{
+    if ( !buffer_age || ( m_surface == EGL_NO_SURFACE ))
+        return 0;
+
+    EGLint age = 0;
+    if ( !eglQuerySurface( m_display, m_surface, EGL_BUFFER_AGE_EXT, &age ))
+        return 0;
+
+    return static_cast<unsigned int>( age );
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::swapBuffers()
+{
+    if ( m_damage.empty() || !swap_buffers_with_damage )
+    {
+        eglCheck( eglSwapBuffers( m_display, m_surface ));
+        m_damage.clear();
+        return;
+    }
+
+    // EGL rectangles have their origin at the bottom-left corner of the surface
+    std::vector<EGLint> rects( m_damage.begin(), m_damage.end() );
+    for ( std::size_t i = 0; i < rects.size(); i += 4 )
+        rects[i + 1] = static_cast<EGLint>( m_height ) - rects[i + 1] - rects[i + 3];
+
+    eglCheck( swap_buffers_with_damage( m_display, m_surface, &rects[0], static_cast<EGLint>( rects.size() / 4 )));
+    m_damage.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+FrameTiming DRMContext::getFrameTiming() const
+{
+    FrameTiming timing;
+
+    if ( !m_scanout || !outputs[m_output].drm.mode )
+        return timing;
+
+    // Pick up flips that completed since the last call, but never block.
+    // Handling them may queue the next flip, which only the thread that
+    // presents the frames may do, the others get the last known timing
+    if ( m_waitingForFlip && ( getEventFileDescriptor() >= 0 ))
+        dispatch_drm_events( 0 );
+
+    timing.frameCount = m_vblankCount;
+    timing.presentTime = m_presentTime;
+    timing.lateFrames = m_lateFrames;
+    timing.droppedFrames = m_droppedFrames;
+
+    // The exact refresh period follows from the mode timings (clock is in kHz)
+    const drmModeModeInfo *mode = outputs[m_output].drm.mode;
+    if ( mode->clock )
+        timing.refreshPeriod = microseconds( static_cast<Int64>( mode->htotal ) * mode->vtotal * 1000 / mode->clock );
+
+    // Predict the next vblank by stepping whole refresh periods from the last flip
+    timing.nextVblank = m_presentTime + timing.refreshPeriod;
+    if (( m_presentTime != Time::Zero ) && ( timing.refreshPeriod != Time::Zero ))
+    {
+        Time now = monotonic_time();
+        if ( timing.nextVblank < now )
+        {
+            Int64 periods = ( now - m_presentTime ).asMicroseconds() / timing.refreshPeriod.asMicroseconds() + 1;
+            timing.nextVblank = m_presentTime + timing.refreshPeriod * periods;
+        }
+    }
+
+    return timing;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DRMContext::sleepUntil(Time time)
+{
+    if ( !m_scanout || !outputs[m_output].drm.mode )
+        return false;
+
+    // An absolute monotonic sleep doesn't drift with the time spent before it
+    timespec deadline;
+    deadline.tv_sec = time.asMicroseconds() / 1000000;
+    deadline.tv_nsec = ( time.asMicroseconds() % 1000000 ) * 1000;
+
+    while ( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL ) == EINTR )
+        ;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DRMContext::isVerticalSyncActive() const
+{
+    return m_verticalSync || !low_latency;
 }
 
 
 ////////////////////////////////////////////////////////////
 void DRMContext::setVerticalSyncEnabled(bool enabled)
 {
+    m_verticalSync = enabled;
+
+    // The page flips are done by display(), but keep EGL consistent for pbuffers
     eglCheck(eglSwapInterval(m_display, enabled ? 1 : 0));
 }
 
 
 ////////////////////////////////////////////////////////////
-void DRMContext::createContext(DRMContext* shared)
+void DRMContext::createContext(DRMContext* shared, const ContextSettings& settings)
 {
     const EGLint contextVersion[] = {
-        EGL_CONTEXT_CLIENT_VERSION, 1,
+        EGL_CONTEXT_CLIENT_VERSION, isProgrammable( settings ) ? 2 : 1,
         EGL_NONE
     };
 
@@ -504,6 +1247,11 @@ void DRMContext::createContext(DRMContext* shared)
     else
         toShared = EGL_NO_CONTEXT;
 
+    // A programmable context is OpenGL ES 2 while the shared context, created with
+    // ContextSettings(), is OpenGL ES 1: textures and buffers are still shared since
+    // EGL only requires both to use the same client API (EGL_OPENGL_ES_API). Mesa's EGL,
+    // which the GBM drivers use (vc4/v3d on the Raspberry Pi), accepts it whatever the ES
+    // version; it wasn't tested on hardware, nor checked with other vendors' GBM drivers
     if (toShared != EGL_NO_CONTEXT)
         eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
 
@@ -517,6 +1265,26 @@ void DRMContext::createContext(DRMContext* shared)
 ////////////////////////////////////////////////////////////
 void DRMContext::createSurface( int width, int height, int bpp, bool scanout )
 {
+    if ( headless )
+    {
+        // Nothing is shown, windows render into a pbuffer of their size
+        const EGLint attributes[] = {
+            EGL_WIDTH, width,
+            EGL_HEIGHT, height,
+            EGL_NONE
+        };
+
+        m_scanout = false;
+        m_width = width;
+        m_height = height;
+        m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attributes));
+
+        if ( m_surface == EGL_NO_SURFACE )
+            err() << "Failed to create EGL pbuffer surface" << std::endl;
+
+        return;
+    }
+
     uint32_t flags = GBM_BO_USE_RENDERING;
 
     m_scanout = scanout;
@@ -539,6 +1307,24 @@ void DRMContext::createSurface( int width, int height, int bpp, bool scanout )
     m_width = width;
     m_height = height;
 
+    bool overlay = m_owner && m_owner->isOverlay();
+
+    if ( m_scanout && my_drm.atomic )
+    {
+        // With atomic modesetting every window gets a plane of its own
+        m_plane = take_plane( &outputs[m_output].drm, overlay ? DRM_PLANE_TYPE_OVERLAY : DRM_PLANE_TYPE_PRIMARY );
+        if ( !m_plane )
+        {
+            err() << "No free " << ( overlay ? "overlay" : "primary" ) << " plane, the window won't be shown" << std::endl;
+            m_scanout = false;
+        }
+    }
+    else if ( m_scanout && overlay )
+    {
+        err() << "Overlay windows require atomic modesetting (set SFML_DRM_ATOMIC)" << std::endl;
+        m_scanout = false;
+    }
+
     if (eglCreatePlatformWindowSurfaceEXT)
     {
         m_surface = eglCheck(eglCreatePlatformWindowSurfaceEXT(m_display, m_config, (void *)m_gbm_surface, NULL));
@@ -561,7 +1347,8 @@ void DRMContext::destroySurface()
     eglCheck(eglDestroySurface(m_display, m_surface));
     m_surface = EGL_NO_SURFACE;
 
-    gbm_surface_destroy( m_gbm_surface );
+    if ( m_gbm_surface )
+        gbm_surface_destroy( m_gbm_surface );
     m_gbm_surface = NULL;
 
     // Ensure that this context is no longer active since our surface is now destroyed
@@ -583,9 +1370,9 @@ EGLConfig DRMContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixe
         EGL_RED_SIZE, 8,
         EGL_ALPHA_SIZE, 8,
 
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        EGL_SURFACE_TYPE, headless ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
 #if defined(SFML_OPENGL_ES)
-        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT,
+        EGL_RENDERABLE_TYPE, isProgrammable( settings ) ? EGL_OPENGL_ES2_BIT : EGL_OPENGL_ES_BIT,
 #else
         EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
 #endif
@@ -635,6 +1422,289 @@ struct drm *DRMContext::get_drm()
     return &my_drm;
 }
 
+
+////////////////////////////////////////////////////////////
+bool DRMContext::isHeadless()
+{
+    check_init();
+    return headless;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int DRMContext::acquireOutput()
+{
+    check_init();
+    if ( !initialized || headless )
+        return 0;
+
+    for ( unsigned int i = 0; i < output_count; ++i )
+    {
+        if ( outputs[i].windows == 0 )
+        {
+            outputs[i].windows++;
+            return i;
+        }
+    }
+
+    // Set up the next connected connector, on a crtc that isn't used yet
+    if ( output_count < MAX_OUTPUTS )
+    {
+        uint32_t connectors[MAX_OUTPUTS];
+        uint32_t crtcs[MAX_OUTPUTS];
+        for ( unsigned int i = 0; i < output_count; ++i )
+        {
+            connectors[i] = outputs[i].drm.connector_id;
+            crtcs[i] = outputs[i].drm.crtc_id;
+        }
+
+        output &out = outputs[output_count];
+        if ( init_drm_output( &out.drm, my_drm.fd, connectors, crtcs, output_count ) == 0 )
+        {
+            if ( my_drm.atomic && ( init_drm_atomic( &out.drm ) < 0 ))
+                err() << "Atomic modesetting not available on output " << output_count << std::endl;
+
+            out.windows = 1;
+            return output_count++;
+        }
+    }
+
+    // All the outputs are busy, share the primary one
+    outputs[0].windows++;
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::releaseOutput(unsigned int index)
+{
+    if (( index < output_count ) && ( outputs[index].windows > 0 ))
+        outputs[index].windows--;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u DRMContext::getOutputSize(unsigned int index)
+{
+    check_init();
+
+    if (( index >= output_count ) || !outputs[index].drm.mode )
+        return Vector2u( 0, 0 );
+
+    return Vector2u( outputs[index].drm.mode->hdisplay, outputs[index].drm.mode->vdisplay );
+}
+
+
+////////////////////////////////////////////////////////////
+VideoMode DRMContext::getDesktopMode()
+{
+    check_init();
+
+    if ( !desktop_mode )
+        return VideoMode( 0, 0 );
+
+    return VideoMode( desktop_mode->hdisplay, desktop_mode->vdisplay, 32, desktop_mode->vrefresh );
+}
+
+
+////////////////////////////////////////////////////////////
+bool DRMContext::setOutputMode(unsigned int index, const VideoMode& mode)
+{
+    check_init();
+
+    if (( index >= output_count ) || !outputs[index].drm.mode || !outputs[index].drm.saved_connector )
+        return false;
+
+    struct drm &drm = outputs[index].drm;
+    drmModeConnectorPtr conn = drm.saved_connector;
+
+    const drmModeModeInfo *current = drm.mode;
+    if (( current->hdisplay == mode.width ) && ( current->vdisplay == mode.height )
+        && (( mode.refreshRate == 0 ) || ( current->vrefresh == mode.refreshRate )))
+        return true;
+
+    //
+    // The window switching the output is already counted, the surfaces of
+    // the other windows shown on it would no longer match the mode
+    //
+    if ( outputs[index].windows > 1 )
+    {
+        err() << "Video mode " << mode.width << "x" << mode.height << "@" << mode.refreshRate
+            << " not set, output " << index << " is used by another window" << std::endl;
+        return false;
+    }
+
+    //
+    // Without a refresh rate, go back to the desktop mode if it has the
+    // requested size, else take the fastest progressive mode
+    //
+    drmModeModeInfo *found = NULL;
+    bool found_interlaced = false;
+    for ( int i = 0; i < conn->count_modes; i++ )
+    {
+        drmModeModeInfo *candidate = &conn->modes[i];
+
+        if (( candidate->hdisplay != mode.width ) || ( candidate->vdisplay != mode.height ))
+            continue;
+
+        if (( mode.refreshRate != 0 ) && ( candidate->vrefresh != mode.refreshRate ))
+            continue;
+
+        if (( index == 0 ) && ( candidate == desktop_mode ) && ( mode.refreshRate == 0 ))
+        {
+            found = candidate;
+            break;
+        }
+
+        bool interlaced = ( candidate->flags & DRM_MODE_FLAG_INTERLACE ) != 0;
+        if ( !found || ( found_interlaced && !interlaced )
+            || (( found_interlaced == interlaced ) && ( candidate->vrefresh > found->vrefresh )))
+        {
+            found = candidate;
+            found_interlaced = interlaced;
+        }
+    }
+
+    if ( !found )
+    {
+        err() << "Video mode " << mode.width << "x" << mode.height << "@" << mode.refreshRate
+            << " not supported by output " << index << ", keeping the current mode" << std::endl;
+        return false;
+    }
+
+    //
+    // Atomic commits set the mode through a property blob
+    //
+    if ( drm.atomic )
+    {
+        uint32_t blob_id = 0;
+        if ( drmModeCreatePropertyBlob( drm.fd, found, sizeof( *found ), &blob_id ))
+        {
+            err() << "Failed to create mode property blob: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        drmModeDestroyPropertyBlob( drm.fd, drm.mode_blob_id );
+        drm.mode_blob_id = blob_id;
+    }
+
+    drm.mode = found;
+
+    // The next flip (drmModeSetCrtc or an atomic commit allowed to modeset) applies it
+    outputs[index].modeset_done = false;
+
+    if ( getenv( "SFML_DRM_DEBUG" ))
+        err() << "DRM mode switched: " << found->name << "@" << found->vrefresh << std::endl;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::setCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot)
+{
+    check_init();
+    if ( !initialized || headless )
+        return;
+
+    uint64_t capWidth = 64;
+    uint64_t capHeight = 64;
+    drmGetCap( my_drm.fd, DRM_CAP_CURSOR_WIDTH, &capWidth );
+    drmGetCap( my_drm.fd, DRM_CAP_CURSOR_HEIGHT, &capHeight );
+
+    if (( width > capWidth ) || ( height > capHeight ))
+    {
+        err() << "Cursor image is too big for the hardware cursor ("
+              << width << "x" << height << ", maximum is "
+              << capWidth << "x" << capHeight << ")" << std::endl;
+        return;
+    }
+
+    sf::Lock lock( cursor_mutex );
+
+    if ( !cursor_bo )
+    {
+        cursor_bo = gbm_bo_create( my_gbm_device, capWidth, capHeight,
+            GBM_FORMAT_ARGB8888, GBM_BO_USE_CURSOR | GBM_BO_USE_WRITE );
+
+        if ( !cursor_bo )
+        {
+            err() << "Failed to create hardware cursor buffer" << std::endl;
+            return;
+        }
+    }
+
+    // The cursor plane expects premultiplied ARGB, padded to the full buffer size
+    std::vector<Uint32> argb( capWidth * capHeight, 0 );
+    for ( unsigned int y = 0; y < height; ++y )
+    {
+        for ( unsigned int x = 0; x < width; ++x )
+        {
+            const Uint8* p = pixels + ( y * width + x ) * 4;
+            Uint32 a = p[3];
+            argb[y * capWidth + x] = ( a << 24 )
+                | (( p[0] * a / 255 ) << 16 )
+                | (( p[1] * a / 255 ) << 8 )
+                | ( p[2] * a / 255 );
+        }
+    }
+
+    if ( gbm_bo_write( cursor_bo, &argb[0], argb.size() * sizeof( Uint32 )))
+    {
+        err() << "Failed to upload hardware cursor image" << std::endl;
+        return;
+    }
+
+    cursor_hotspot = hotspot;
+    update_cursor();
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::setCursorVisible(bool visible)
+{
+    sf::Lock lock( cursor_mutex );
+
+    cursor_visible = visible;
+
+    if ( initialized )
+        update_cursor();
+}
+
+
+////////////////////////////////////////////////////////////
+int DRMContext::getEventFileDescriptor()
+{
+    if ( !initialized || headless || !display_thread_known
+            || !pthread_equal( display_thread, pthread_self() ))
+        return -1;
+
+    return my_drm.fd;
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::dispatchEvents()
+{
+    if ( getEventFileDescriptor() >= 0 )
+        dispatch_drm_events( 0 );
+}
+
+
+////////////////////////////////////////////////////////////
+void DRMContext::moveCursor(const Vector2i& position)
+{
+    // Called from the input thread when there is one
+    sf::Lock lock( cursor_mutex );
+
+    cursor_position = position;
+
+    if ( cursor_shown )
+        drmModeMoveCursor( my_drm.fd, my_drm.crtc_id,
+            position.x - static_cast<int>( cursor_hotspot.x ),
+            position.y - static_cast<int>( cursor_hotspot.y ));
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -35,12 +35,15 @@
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/EGLCheck.hpp>
 #include <SFML/Window/GlContext.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <SFML/OpenGL.hpp>
 
 #include <gbm.h>
 #include <xf86drmMode.h>
+#include <vector>
 
 struct drm;
+struct plane;
 
 namespace sf
 {
@@ -118,15 +121,72 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing of the last frame presented on screen
+    ///
+    /// Page flips that completed since the last call are only
+    /// handled when called from the thread that calls display().
+    ///
+    /// \return Timing reported by the last page flip event
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual FrameTiming getFrameTiming() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sleep until the given time
+    ///
+    /// \param time Time to wake up at, in the monotonic time base
+    ///
+    /// \return True if the context waited, false if it doesn't show on screen
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool sleepUntil(Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the frames are shown at vertical blanks
+    ///
+    /// Vsync can only be disabled with the "async" and "mailbox"
+    /// modes of SFML_DRM_PRESENT_MODE.
+    ///
+    /// \return True if display() presents at vertical blanks
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool isVerticalSyncActive() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the regions that changed in the frame
+    ///        presented by the next call to display()
+    ///
+    /// The regions are passed to eglSwapBuffersWithDamage and,
+    /// with atomic modesetting, to the FB_DAMAGE_CLIPS property
+    /// of the plane.
+    ///
+    /// \param rects Array of 4 * \a count integers
+    /// \param count Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setDamage(const Int32* rects, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer (EGL_EXT_buffer_age)
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBufferAge() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the context
     ///
-    /// \param shared       Context to share the new one with (can be NULL)
-    /// \param bitsPerPixel Pixel depth, in bits per pixel
-    /// \param settings     Creation parameters
+    /// On OpenGL ES, an OpenGL ES 2 context is created when
+    /// \a settings has the ContextSettings::Programmable
+    /// attribute, and an OpenGL ES 1 context otherwise.
+    ///
+    /// \param shared   Context to share the new one with (can be NULL)
+    /// \param settings Creation parameters
     ///
     ////////////////////////////////////////////////////////////
-    void createContext(DRMContext* shared);
+    void createContext(DRMContext* shared, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the surface
@@ -158,8 +218,190 @@ public:
 
     static struct drm *get_drm();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether rendering happens without any display
+    ///
+    /// Headless mode is selected with the SFML_DRM_HEADLESS
+    /// environment variable, or when no DRM device can be used.
+    /// Contexts then render into EGL pbuffers.
+    ///
+    /// \return True if there is no DRM device
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isHeadless();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pick the output (connector and crtc) a new window
+    ///        is shown on
+    ///
+    /// Each window takes the first connected output that has no
+    /// window yet. Once all of them are used, windows share the
+    /// primary output.
+    ///
+    /// \return Index of the output, 0 being the primary output
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int acquireOutput();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give back an output picked with acquireOutput()
+    ///
+    /// \param index Index of the output
+    ///
+    ////////////////////////////////////////////////////////////
+    static void releaseOutput(unsigned int index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the video mode of an output
+    ///
+    /// \param index Index of the output
+    ///
+    /// \return Size of the output in pixels, (0, 0) if it is unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    static Vector2u getOutputSize(unsigned int index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video mode of the primary output when
+    ///        SFML started
+    ///
+    /// This is the mode chosen with "SFML_DRM_MODE" and
+    /// "SFML_DRM_REFRESH", it doesn't change with setOutputMode().
+    ///
+    /// \return Desktop video mode, 0x0 if there is no display
+    ///
+    ////////////////////////////////////////////////////////////
+    static VideoMode getDesktopMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Switch an output to another mode of its connector
+    ///
+    /// The crtc is reprogrammed by the next page flip of the
+    /// output, so this must be called before the context of the
+    /// window shown on it is created. The EGL display and the
+    /// other contexts are kept.
+    ///
+    /// The mode is not switched while another window is shown
+    /// on the output, since its surface would no longer match.
+    ///
+    /// \param index Index of the output
+    /// \param mode  Requested size and refresh rate (0 for any)
+    ///
+    /// \return True if the output uses the requested mode
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setOutputMode(unsigned int index, const VideoMode& mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the image of the hardware cursor
+    ///
+    /// The cursor is shown on the cursor plane of the CRTC once
+    /// an image has been set, and is limited to the size given
+    /// by DRM_CAP_CURSOR_WIDTH/HEIGHT (usually 64x64).
+    ///
+    /// \param width   Cursor's width, in pixels
+    /// \param height  Cursor's height, in pixels
+    /// \param pixels  Pointer to the pixels in memory, format must be RGBA 32 bits
+    /// \param hotspot Position of the hotspot in the image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Show or hide the hardware cursor
+    ///
+    /// \param visible True to show, false to hide
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCursorVisible(bool visible);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the hardware cursor
+    ///
+    /// \param position New position of the mouse, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    static void moveCursor(const Vector2i& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptor that becomes readable when
+    ///        page flip events are pending
+    ///
+    /// Page flips are completed by the thread that presents the
+    /// frames, so the descriptor is only given to that thread.
+    ///
+    /// \return DRM file descriptor, or -1 if the calling thread
+    ///         doesn't present frames
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getEventFileDescriptor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Dispatch the pending page flip events without blocking
+    ///
+    /// Only has an effect in the thread that presents the frames.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void dispatchEvents();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle the completion of a page flip
+    ///
+    /// Called from the DRM event handler once the buffer queued
+    /// by the last page flip is being scanned out.
+    ///
+    /// \param vblankCount Vertical blank counter of the flip
+    /// \param timestamp   Time of the flip, as reported by the kernel
+    ///
+    ////////////////////////////////////////////////////////////
+    void pageFlipped(unsigned int vblankCount, Time timestamp);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle the failure of the atomic commit that
+    ///        was supposed to show our buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void flipFailed();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the plane state showing the buffer waiting
+    ///        for its flip to an atomic request
+    ///
+    /// \param req Atomic request being built
+    ///
+    /// \return True on success, false if a property is missing
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addPlaneProperties(drmModeAtomicReq *req);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a page flip to a buffer object
+    ///
+    /// \param bo     Locked front buffer to display
+    /// \param damage FB_DAMAGE_CLIPS blob of the buffer (0 for the whole buffer), owned by the context
+    ///
+    ////////////////////////////////////////////////////////////
+    void queueFlip(struct gbm_bo *bo, uint32_t damage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the pending page flip to complete
+    ///
+    /// \param timeout Timeout in milliseconds, -1 to wait forever
+    ///
+    /// \return True if the flip completed (or none was pending), false on error or timeout
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitForFlip(int timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the EGL buffers, presenting only the
+    ///        damaged regions when the driver supports it
+    ///
+    ////////////////////////////////////////////////////////////
+    void swapBuffers();
+
     ////////////////////////////////////////////////////////////
     /// \brief Helper to copy the picked EGL configuration
     ////////////////////////////////////////////////////////////
@@ -173,13 +415,27 @@ private:
     EGLSurface  m_surface; ///< The internal EGL surface
     EGLConfig   m_config;  ///< The internal EGL config
 
-    struct gbm_bo *m_cur_bo;
-    struct gbm_bo *m_next_bo;
+    struct gbm_bo *m_cur_bo;    ///< Buffer currently scanned out
+    struct gbm_bo *m_next_bo;   ///< Buffer waiting for its page flip to complete
+    struct gbm_bo *m_queued_bo; ///< Rendered buffer waiting for the pending flip (triple buffering)
     struct gbm_surface *m_gbm_surface;
     int m_width;
     int m_height;
     bool m_shown;
     bool m_scanout;
+    bool m_waitingForFlip;      ///< Is a page flip pending?
+    bool m_verticalSync;        ///< Was vsync requested? Only disabled with SFML_DRM_PRESENT_MODE
+    Uint64 m_frameCount;        ///< Number of completed page flips
+    Uint64 m_lateFrames;        ///< Number of frames where display() had to wait for scanout
+    Uint64 m_droppedFrames;     ///< Number of rendered frames that never reached the screen
+    Uint64 m_vblankCount;       ///< Vertical blank counter of the last completed flip
+    Time m_presentTime;         ///< Time of the last completed flip
+    const WindowImplDRM *m_owner; ///< Window shown by this context, if any
+    struct plane *m_plane;      ///< Plane used with atomic modesetting, if any
+    std::vector<Int32> m_damage; ///< Damaged regions of the frame being rendered (left, top, width, height)
+    uint32_t m_next_damage;     ///< FB_DAMAGE_CLIPS blob of the buffer waiting for the pending flip
+    uint32_t m_queued_damage;   ///< FB_DAMAGE_CLIPS blob of the queued buffer
+    unsigned int m_output;      ///< Index of the output the context is shown on
 };
 
 } // namespace priv
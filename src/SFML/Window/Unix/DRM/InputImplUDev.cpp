@@ -32,11 +32,13 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Thread.hpp>
 
 #include <sstream>
 #include <string>
 #include <vector>
 #include <queue>
+#include <algorithm>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -46,10 +48,20 @@
 #include <fcntl.h>
 #include <termios.h>
 #include <unistd.h>
+#include <time.h>
 
 #include <linux/input.h>
+#include <libudev.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 #include <errno.h>
 
+#ifdef SFML_HAVE_XKBCOMMON
+#include <xkbcommon/xkbcommon.h>
+#include <xkbcommon/xkbcommon-compose.h>
+#endif
+
 namespace
 {
     struct TouchSlot {
@@ -68,20 +80,129 @@ namespace
 
     sf::Mutex         inpMutex;                                // threadsafe? maybe...
     sf::Vector2i      mousePos;                                // current mouse position
+    sf::Vector2u      mouseArea;                               // area relative moves are clamped to, (0, 0) for none
+
+    struct InputDevice
+    {
+        std::string deviceNode;                                // e.g. /dev/input/event3
+        unsigned int id;                                       // number of the event node
+        int fd;
+        bool monotonic;                                        // are the event times from CLOCK_MONOTONIC?
+        bool keyboard;
+        bool mouse;
+        bool touch;
+    };
 
-    std::vector<int>  fds;                                     // list of open file descriptors for /dev/input
+    std::vector<InputDevice> devices;                          // list of open devices from /dev/input
+    unsigned int deviceGeneration = 0;                         // incremented when a device is added or removed
+    udev* udevContext = NULL;
+    udev_monitor* udevMonitor = NULL;                          // notifies us of devices being added or removed
     std::vector<bool> mouseMap(sf::Mouse::ButtonCount, false); // track whether keys are down
     std::vector<bool> keyMap(sf::Keyboard::KeyCount, false);   // track whether mouse buttons are down
 
-    int touchFd = -1;                                          // file descriptor we have seen MT events on; assumes only 1
+    int touchDevice = -1;                                      // id of the device we have seen MT events on; assumes only 1
     std::vector<TouchSlot> touchSlots;                         // track the state of each touch "slot"
     int currentSlot = 0;                                       // which slot are we currently updating?
 
+    sf::Time eventTime;                                        // timestamp given to the events being converted
+
+    bool coalesceMotion = false;                               // merge the motion events, see SFML_INPUT_COALESCE
+    bool motionPending = false;                                // has the mouse moved since the last SYN_REPORT?
+
     std::queue<sf::Event> eventQueue;                          // events received and waiting to be consumed
-    const int MAX_QUEUE = 64;                                  // The maximum size we let eventQueue grow to
+    const int MAX_QUEUE = 256;                                 // The maximum size we let eventQueue grow to
+    const int READ_SIZE = 64;                                  // The number of input_events read from a device at once
+
+    // With the input thread, events go through a lock-free ring instead of
+    // eventQueue: the input thread is the only one to push and the thread
+    // polling the window events the only one to pop
+    bool threaded = false;                                     // are the devices read by the input thread? (cleared if it fails)
+    sf::Thread* inputThread = NULL;
+    int notifyFd = -1;                                         // eventfd signaled when the input thread queued events
+    int stopFd = -1;                                           // eventfd signaled to stop the input thread
+    const unsigned int RING_SIZE = 1024;                       // capacity of the ring, must be a power of two
+    sf::Event ring[RING_SIZE];
+    unsigned int ringHead = 0;                                 // next slot to write, only written by the input thread
+    unsigned int ringTail = 0;                                 // next slot to read, only written by the consumer
+
+    unsigned int maxQueueSize = 0;                             // statistics, see sf::InputStatistics
+    sf::Uint64 queuedEvents = 0;
+    sf::Uint64 droppedEvents = 0;
 
     termios newt, oldt;                                        // Terminal configurations
 
+#ifdef SFML_HAVE_XKBCOMMON
+    xkb_context* xkbContext = NULL;                            // keymap and compose state converting keys to text
+    xkb_keymap* xkbKeymap = NULL;
+    xkb_state* xkbState = NULL;
+    xkb_compose_table* xkbComposeTable = NULL;
+    xkb_compose_state* xkbComposeState = NULL;
+#endif
+    bool keymapText = false;                                   // is the text converted from the keys instead of read from stdin?
+
+    sf::priv::InputImpl::MouseMovedCallback mouseMovedCallback = NULL; // notified of every mouse move
+
+    // Input recordings, see SFML_INPUT_RECORD and SFML_INPUT_REPLAY.  A
+    // recording is the RECORD_MAGIC header followed by InputRecords in
+    // the byte order of the machine that made it
+    enum RecordKind
+    {
+        RecordEvent,                                           // an input_event read from a device
+        RecordConnect,                                         // a device was plugged in, flags tell what it is
+        RecordDisconnect,                                      // a device was removed
+        RecordText                                             // a character read from the terminal
+    };
+
+    enum RecordFlags
+    {
+        RecordKeyboard = 1 << 0,
+        RecordMouse    = 1 << 1,
+        RecordTouch    = 1 << 2
+    };
+
+    struct InputRecord
+    {
+        sf::Int64 time;                                        // microseconds since the recording started
+        sf::Uint32 device;                                     // id of the device
+        sf::Uint16 kind;                                       // one of RecordKind
+        sf::Uint16 type;                                       // input_event type
+        sf::Uint16 code;                                       // input_event code
+        sf::Uint16 flags;                                      // RecordFlags of a connected device
+        sf::Int32 value;                                       // input_event value, or the character
+    };
+
+    const char RECORD_MAGIC[8] = { 'S', 'F', 'I', 'N', 'P', 'U', 'T', '1' };
+
+    FILE* recordFile = NULL;                                   // recording being written
+    sf::Time recordStart;                                      // time of the start of the recording
+    FILE* replayFile = NULL;                                   // recording being replayed instead of the devices
+    sf::Time replayStart;                                      // time at which the replay started
+    InputRecord replayRecord;                                  // next record to replay
+    bool replayPending = false;                                // is replayRecord valid?
+    int replayTimerFd = -1;                                    // timerfd expiring when replayRecord is due
+
+    // Current time in the time base used by sf::Clock
+    sf::Time monotonicTime()
+    {
+        timespec time;
+        clock_gettime( CLOCK_MONOTONIC, &time );
+        return sf::microseconds( static_cast<sf::Int64>( time.tv_sec ) * 1000000 + time.tv_nsec / 1000 );
+    }
+
+    // Time of an input_event in the time base used by sf::Clock
+    sf::Time toEventTime( const InputDevice& device, const struct input_event& ie )
+    {
+        sf::Time time = sf::microseconds( static_cast<sf::Int64>( ie.time.tv_sec ) * 1000000 + ie.time.tv_usec );
+        if ( device.monotonic )
+            return time;
+
+        // Kernels without EVIOCSCLOCKID report the wall clock time
+        timespec realtime;
+        clock_gettime( CLOCK_REALTIME, &realtime );
+        sf::Time offset = sf::microseconds( static_cast<sf::Int64>( realtime.tv_sec ) * 1000000 + realtime.tv_nsec / 1000 ) - monotonicTime();
+        return time - offset;
+    }
+
     bool altDown() { return ( keyMap[sf::Keyboard::LAlt] || keyMap[sf::Keyboard::RAlt] ); }
     bool controlDown() { return ( keyMap[sf::Keyboard::LControl] || keyMap[sf::Keyboard::RControl] ); }
     bool shiftDown() { return ( keyMap[sf::Keyboard::LShift] || keyMap[sf::Keyboard::RShift] ); }
@@ -89,8 +210,80 @@ namespace
 
     void uninit( void )
     {
-        for ( std::vector<int>::iterator itr=fds.begin(); itr != fds.end(); ++itr )
-            close( *itr );
+        if ( inputThread )
+        {
+            uint64_t value = 1;
+            write( stopFd, &value, sizeof( value ));
+            inputThread->wait();
+            delete inputThread;
+            inputThread = NULL;
+        }
+
+        for ( std::vector<InputDevice>::iterator itr=devices.begin(); itr != devices.end(); ++itr )
+            close( itr->fd );
+
+        if ( udevMonitor )
+            udev_monitor_unref( udevMonitor );
+
+        if ( udevContext )
+            udev_unref( udevContext );
+
+        if ( recordFile )
+            fclose( recordFile );
+
+        if ( replayFile )
+            fclose( replayFile );
+
+#ifdef SFML_HAVE_XKBCOMMON
+        if ( xkbComposeState )
+            xkb_compose_state_unref( xkbComposeState );
+
+        if ( xkbComposeTable )
+            xkb_compose_table_unref( xkbComposeTable );
+
+        if ( xkbState )
+            xkb_state_unref( xkbState );
+
+        if ( xkbKeymap )
+            xkb_keymap_unref( xkbKeymap );
+
+        if ( xkbContext )
+            xkb_context_unref( xkbContext );
+#endif
+    }
+
+    void initKeymap()
+    {
+#ifdef SFML_HAVE_XKBCOMMON
+        // The layout is taken from the XKB_DEFAULT_LAYOUT, XKB_DEFAULT_VARIANT,
+        // XKB_DEFAULT_OPTIONS... environment variables, "us" if they aren't set
+        xkbContext = xkb_context_new( XKB_CONTEXT_NO_FLAGS );
+        if ( xkbContext )
+            xkbKeymap = xkb_keymap_new_from_names( xkbContext, NULL, XKB_KEYMAP_COMPILE_NO_FLAGS );
+        if ( xkbKeymap )
+            xkbState = xkb_state_new( xkbKeymap );
+
+        if ( !xkbState )
+        {
+            sf::err() << "Failed to create the keymap, text input will be read from the terminal" << std::endl;
+            return;
+        }
+
+        // Dead keys and compose sequences depend on the locale
+        const char* locale = getenv( "LC_ALL" );
+        if ( !locale || !*locale )
+            locale = getenv( "LC_CTYPE" );
+        if ( !locale || !*locale )
+            locale = getenv( "LANG" );
+        if ( !locale || !*locale )
+            locale = "C";
+
+        xkbComposeTable = xkb_compose_table_new_from_locale( xkbContext, locale, XKB_COMPOSE_COMPILE_NO_FLAGS );
+        if ( xkbComposeTable )
+            xkbComposeState = xkb_compose_state_new( xkbComposeTable, XKB_COMPOSE_STATE_NO_FLAGS );
+
+        keymapText = true;
+#endif
     }
 
 #define BITS_PER_LONG           (sizeof(unsigned long) * 8)
@@ -100,27 +293,32 @@ namespace
 #define test_bit(bit, array)    ((array[LONG(bit)] >> OFF(bit)) & 1)
 
     //
-    // Only keep fds that we think are a keyboard, mouse or touchpad/touchscreen
+    // Only keep devices that we think are a keyboard, mouse or touchpad/touchscreen
     //
     // Joysticks are handled in /src/SFML/Window/Unix/JoystickImpl.cpp
     //
-    bool keep_fd( int fd )
+    bool probeDevice( InputDevice& device )
     {
         unsigned long bitmask_ev[NBITS(EV_MAX)];
         unsigned long bitmask_key[NBITS(KEY_MAX)];
         unsigned long bitmask_abs[NBITS(ABS_MAX)];
         unsigned long bitmask_rel[NBITS(REL_MAX)];
 
-        ioctl( fd, EVIOCGBIT( 0, sizeof( bitmask_ev ) ), &bitmask_ev );
-        ioctl( fd, EVIOCGBIT( EV_KEY, sizeof( bitmask_key ) ), &bitmask_key );
-        ioctl( fd, EVIOCGBIT( EV_ABS, sizeof( bitmask_abs ) ), &bitmask_abs );
-        ioctl( fd, EVIOCGBIT( EV_REL, sizeof( bitmask_rel ) ), &bitmask_rel );
+        memset( bitmask_ev, 0, sizeof( bitmask_ev ));
+        memset( bitmask_key, 0, sizeof( bitmask_key ));
+        memset( bitmask_abs, 0, sizeof( bitmask_abs ));
+        memset( bitmask_rel, 0, sizeof( bitmask_rel ));
+
+        ioctl( device.fd, EVIOCGBIT( 0, sizeof( bitmask_ev ) ), &bitmask_ev );
+        ioctl( device.fd, EVIOCGBIT( EV_KEY, sizeof( bitmask_key ) ), &bitmask_key );
+        ioctl( device.fd, EVIOCGBIT( EV_ABS, sizeof( bitmask_abs ) ), &bitmask_abs );
+        ioctl( device.fd, EVIOCGBIT( EV_REL, sizeof( bitmask_rel ) ), &bitmask_rel );
 
         // This is the keyboard test used by SDL
         //
         // the first 32 bits are ESC, numbers and Q to D;  If we have any of those,
         // consider it a keyboard device; do not test for KEY_RESERVED, though
-        bool is_keyboard = ( bitmask_key[0] & 0xFFFFFFFE );
+        device.keyboard = ( bitmask_key[0] & 0xFFFFFFFE );
 
         bool is_abs = test_bit( EV_ABS, bitmask_ev )
             && test_bit( ABS_X, bitmask_abs ) && test_bit( ABS_Y, bitmask_abs );
@@ -128,47 +326,349 @@ namespace
         bool is_rel = test_bit( EV_REL, bitmask_ev )
             && test_bit( REL_X, bitmask_rel ) && test_bit( REL_Y, bitmask_rel );
 
-        bool is_mouse = ( is_abs || is_rel ) && test_bit( BTN_MOUSE, bitmask_key );
+        device.mouse = ( is_abs || is_rel ) && test_bit( BTN_MOUSE, bitmask_key );
 
-        bool is_touch = is_abs && ( test_bit( BTN_TOOL_FINGER, bitmask_key ) || test_bit( BTN_TOUCH, bitmask_key) );
+        device.touch = is_abs && ( test_bit( BTN_TOOL_FINGER, bitmask_key ) || test_bit( BTN_TOUCH, bitmask_key) );
 
-        return is_keyboard || is_mouse || is_touch;
+        return device.keyboard || device.mouse || device.touch;
     }
 
-    void init()
+    bool ringPush( const sf::Event& ev )
     {
-        static bool initialized = false;
-        if ( initialized )
+        unsigned int head = ringHead;
+        unsigned int tail = __atomic_load_n( &ringTail, __ATOMIC_ACQUIRE );
+
+        if ( head - tail >= RING_SIZE )
+            return false;
+
+        ring[head & ( RING_SIZE - 1 )] = ev;
+        __atomic_store_n( &ringHead, head + 1, __ATOMIC_RELEASE );
+        return true;
+    }
+
+    bool ringPop( sf::Event& ev )
+    {
+        unsigned int tail = ringTail;
+        unsigned int head = __atomic_load_n( &ringHead, __ATOMIC_ACQUIRE );
+
+        if ( head == tail )
+            return false;
+
+        ev = ring[tail & ( RING_SIZE - 1 )];
+        __atomic_store_n( &ringTail, tail + 1, __ATOMIC_RELEASE );
+        return true;
+    }
+
+    bool ringPeek( sf::Event& ev )
+    {
+        unsigned int tail = ringTail;
+        unsigned int head = __atomic_load_n( &ringHead, __ATOMIC_ACQUIRE );
+
+        if ( head == tail )
+            return false;
+
+        ev = ring[tail & ( RING_SIZE - 1 )];
+        return true;
+    }
+
+    // Can the motion event b replace a, the event queued just before it?
+    bool canCoalesce( const sf::Event& a, const sf::Event& b )
+    {
+        if ( !coalesceMotion || ( a.type != b.type ))
+            return false;
+
+        return ( a.type == sf::Event::MouseMoved )
+            || (( a.type == sf::Event::TouchMoved ) && ( a.touch.finger == b.touch.finger ));
+    }
+
+    void pushEvent( sf::Event& ev )
+    {
+        unsigned int size;
+        ev.timestamp = eventTime;
+
+        if ( threaded )
+        {
+            // The consumer can't be made to drop its oldest event, so the
+            // newest one is lost when the ring is full
+            if ( !ringPush( ev ))
+            {
+                droppedEvents++;
+                return;
+            }
+
+            size = ringHead - __atomic_load_n( &ringTail, __ATOMIC_ACQUIRE );
+        }
+        else if ( !eventQueue.empty() && canCoalesce( eventQueue.back(), ev ))
+        {
+            // Only the last position of a run of moves matters
+            eventQueue.back() = ev;
             return;
+        }
+        else
+        {
+            if ( eventQueue.size() >= MAX_QUEUE )
+            {
+                eventQueue.pop();
+                droppedEvents++;
+            }
 
-        initialized=true;
+            eventQueue.push( ev );
+            size = eventQueue.size();
+        }
+
+        queuedEvents++;
+        maxQueueSize = std::max( maxQueueSize, size );
+    }
+
+    void pushDeviceEvent( sf::Event::EventType type, const InputDevice& device )
+    {
+        sf::Event ev;
+        ev.type = type;
+        ev.inputDevice.deviceId = device.id;
+        ev.inputDevice.keyboard = device.keyboard;
+        ev.inputDevice.mouse = device.mouse;
+        ev.inputDevice.touch = device.touch;
+        pushEvent( ev );
+    }
+
+    void writeRecord( RecordKind kind, unsigned int deviceId, const struct input_event* ie, int value, int flags )
+    {
+        InputRecord record;
+        record.time = ( eventTime - recordStart ).asMicroseconds();
+        record.device = deviceId;
+        record.kind = kind;
+        record.type = ie ? ie->type : 0;
+        record.code = ie ? ie->code : 0;
+        record.flags = flags;
+        record.value = ie ? ie->value : value;
+
+        if ( fwrite( &record, sizeof( record ), 1, recordFile ) != 1 )
+        {
+            sf::err() << "Failed to write the input recording, recording stopped" << std::endl;
+            fclose( recordFile );
+            recordFile = NULL;
+        }
+    }
+
+    void recordEvent( const InputDevice& device, const struct input_event& ie )
+    {
+        if ( recordFile )
+            writeRecord( RecordEvent, device.id, &ie, 0, 0 );
+    }
+
+    void recordDevice( RecordKind kind, const InputDevice& device )
+    {
+        if ( !recordFile )
+            return;
+
+        int flags = ( device.keyboard ? RecordKeyboard : 0 )
+            | ( device.mouse ? RecordMouse : 0 )
+            | ( device.touch ? RecordTouch : 0 );
+
+        writeRecord( kind, device.id, NULL, 0, flags );
+    }
+
+    void recordText( unsigned char c )
+    {
+        if ( recordFile )
+            writeRecord( RecordText, 0, NULL, c, 0 );
+    }
+
+    void openDevice( const char* deviceNode, unsigned int id, bool notify )
+    {
+        for ( std::vector<InputDevice>::iterator itr=devices.begin(); itr != devices.end(); ++itr )
+        {
+            if ( itr->deviceNode == deviceNode )
+                return;
+        }
+
+        InputDevice device;
+        device.deviceNode = deviceNode;
+        device.id = id;
+        device.fd = open( deviceNode, O_RDONLY | O_NONBLOCK );
+
+        if ( device.fd < 0 )
+        {
+            if ( errno != ENOENT )
+                sf::err() << "Error opening " << deviceNode << ": " << strerror( errno ) << std::endl;
+
+            return;
+        }
+
+        if ( !probeDevice( device ))
+        {
+            close( device.fd );
+            return;
+        }
 
-        for ( int i=0; i<32; i++ )
+        // Have the kernel timestamp the events with the clock used by sf::Clock
+        device.monotonic = false;
+#ifdef EVIOCSCLOCKID
+        int clock = CLOCK_MONOTONIC;
+        device.monotonic = ( ioctl( device.fd, EVIOCSCLOCKID, &clock ) == 0 );
+#endif
+
+        devices.push_back( device );
+        deviceGeneration++;
+
+        if ( notify )
         {
-            std::string name( "/dev/input/event" );
-            std::ostringstream ss;
-            ss << i;
-            name += ss.str();
+            recordDevice( RecordConnect, device );
+            pushDeviceEvent( sf::Event::InputDeviceConnected, device );
+        }
+    }
 
-            int temp_fd = open( name.c_str(), O_RDONLY | O_NONBLOCK );
+    void closeDevice( std::size_t index )
+    {
+        InputDevice device = devices[index];
+        devices.erase( devices.begin() + index );
+        deviceGeneration++;
+
+        close( device.fd );
+        if ( touchDevice == static_cast<int>( device.id ))
+            touchDevice = -1;
+
+        recordDevice( RecordDisconnect, device );
+        pushDeviceEvent( sf::Event::InputDeviceDisconnected, device );
+    }
 
-            if ( temp_fd < 0 )
+    void closeDevice( const char* deviceNode )
+    {
+        for ( std::size_t i=0; i<devices.size(); i++ )
+        {
+            if ( devices[i].deviceNode == deviceNode )
             {
-                if ( errno != ENOENT )
-                    sf::err() << "Error opening " << name << ": " << strerror( errno ) << std::endl;
+                closeDevice( i );
+                return;
+            }
+        }
+    }
+
+    void initMonitor()
+    {
+        udevMonitor = udev_monitor_new_from_netlink( udevContext, "udev" );
+
+        if ( !udevMonitor )
+        {
+            sf::err() << "Failed to create udev monitor, input devices connected later won't be used" << std::endl;
+            return;
+        }
+
+        if (( udev_monitor_filter_add_match_subsystem_devtype( udevMonitor, "input", NULL ) < 0 )
+                || ( udev_monitor_enable_receiving( udevMonitor ) < 0 ))
+        {
+            sf::err() << "Failed to enable udev monitor, input devices connected later won't be used" << std::endl;
+
+            udev_monitor_unref( udevMonitor );
+            udevMonitor = NULL;
+        }
+    }
+
+    bool scanDevices()
+    {
+        udev_enumerate* udevEnumerator = udev_enumerate_new( udevContext );
+
+        if ( !udevEnumerator )
+            return false;
+
+        if (( udev_enumerate_add_match_subsystem( udevEnumerator, "input" ) < 0 )
+                || ( udev_enumerate_add_match_sysname( udevEnumerator, "event*" ) < 0 )
+                || ( udev_enumerate_scan_devices( udevEnumerator ) < 0 ))
+        {
+            udev_enumerate_unref( udevEnumerator );
+            return false;
+        }
 
+        udev_list_entry* entry;
+        udev_list_entry_foreach( entry, udev_enumerate_get_list_entry( udevEnumerator ))
+        {
+            udev_device* udevDevice = udev_device_new_from_syspath( udevContext, udev_list_entry_get_name( entry ));
+            if ( !udevDevice )
                 continue;
-            }
 
-            if ( keep_fd( temp_fd ) )
-                fds.push_back( temp_fd );
-            else
-                close( temp_fd );
+            const char* devnode = udev_device_get_devnode( udevDevice );
+            const char* sysnum = udev_device_get_sysnum( udevDevice );
+
+            if ( devnode && sysnum )
+                openDevice( devnode, atoi( sysnum ), false );
+
+            udev_device_unref( udevDevice );
+        }
+
+        udev_enumerate_unref( udevEnumerator );
+        return true;
+    }
+
+    void initDevices()
+    {
+        // The monitor is created before scanning, so that no device
+        // connected in between is missed
+        //
+        udevContext = udev_new();
+        if ( udevContext )
+            initMonitor();
+
+        if ( !udevContext || !scanDevices() )
+        {
+            sf::err() << "Failed to enumerate input devices with udev, probing /dev/input" << std::endl;
+
+            for ( int i=0; i<32; i++ )
+            {
+                std::string name( "/dev/input/event" );
+                std::ostringstream ss;
+                ss << i;
+                name += ss.str();
+
+                openDevice( name.c_str(), i, false );
+            }
         }
 
         atexit( uninit );
     }
 
+    bool hasMonitorEvent()
+    {
+        pollfd pfd;
+        pfd.fd = udev_monitor_get_fd( udevMonitor );
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        return ( poll( &pfd, 1, 0 ) > 0 ) && ( pfd.revents & POLLIN );
+    }
+
+    // assumes inpMutex is locked
+    void updateDevices()
+    {
+        if ( !udevMonitor )
+            return;
+
+        eventTime = monotonicTime();
+
+        while ( hasMonitorEvent() )
+        {
+            udev_device* udevDevice = udev_monitor_receive_device( udevMonitor );
+            if ( !udevDevice )
+                continue;
+
+            const char* action = udev_device_get_action( udevDevice );
+            const char* devnode = udev_device_get_devnode( udevDevice );
+            const char* sysname = udev_device_get_sysname( udevDevice );
+            const char* sysnum = udev_device_get_sysnum( udevDevice );
+
+            // Only the event nodes are read, not the legacy mouse/js nodes
+            if ( action && devnode && sysnum && sysname
+                    && ( strncmp( sysname, "event", 5 ) == 0 ))
+            {
+                if ( strcmp( action, "add" ) == 0 )
+                    openDevice( devnode, atoi( sysnum ), true );
+                else if ( strcmp( action, "remove" ) == 0 )
+                    closeDevice( devnode );
+            }
+
+            udev_device_unref( udevDevice );
+        }
+    }
+
     sf::Mouse::Button toMouseButton( int c )
     {
         switch ( c )
@@ -301,14 +801,6 @@ namespace
         }
     }
 
-    void pushEvent( sf::Event& ev )
-    {
-        if ( eventQueue.size() >= MAX_QUEUE )
-            eventQueue.pop();
-
-        eventQueue.push( ev );
-    }
-
     TouchSlot& atSlot( int idx )
     {
         if ( idx >= touchSlots.size() )
@@ -351,177 +843,312 @@ namespace
         }
     }
 
-    bool eventProcess( sf::Event &ev )
+    void pushMouseMoved()
     {
-        sf::Lock lock( inpMutex );
+        if ( mouseMovedCallback )
+            mouseMovedCallback( mousePos );
 
-        // Ensure that we are initialized
-        //
-        init();
+        sf::Event ev;
+        ev.type = sf::Event::MouseMoved;
+        ev.mouseMove.x = mousePos.x;
+        ev.mouseMove.y = mousePos.y;
+        pushEvent( ev );
 
-        // This is for handling the Backspace and DEL text events, which we
-        // generate based on keystrokes (and not stdin)
-        //
-        static int doDeferredText=0;
-        if ( doDeferredText )
+        motionPending = false;
+    }
+
+#ifdef SFML_HAVE_XKBCOMMON
+    // assumes inpMutex is locked
+    void processKeyText( const struct input_event& ie )
+    {
+        // evdev key codes are offset by 8 in XKB keymaps
+        xkb_keycode_t keycode = ie.code + 8;
+
+        if ( ie.value == 0 )
         {
-            ev.type = sf::Event::TextEntered;
-            ev.text.unicode = doDeferredText;
-            doDeferredText = 0;
-            return true;
+            xkb_state_update_key( xkbState, keycode, XKB_KEY_UP );
+            return;
         }
 
-        // Check all the open file descriptors for the next event
-        //
-        for ( std::vector<int>::iterator itr=fds.begin(); itr != fds.end(); ++itr )
+        if ( ie.value == 1 )
+            xkb_state_update_key( xkbState, keycode, XKB_KEY_DOWN );
+        else if ( !xkb_keymap_key_repeats( xkbKeymap, keycode ))
+            return;
+
+        sf::Uint32 unicode = 0;
+        xkb_keysym_t keysym = xkb_state_key_get_one_sym( xkbState, keycode );
+
+        if ( xkbComposeState
+                && ( xkb_compose_state_feed( xkbComposeState, keysym ) == XKB_COMPOSE_FEED_ACCEPTED ))
         {
-            struct input_event ie;
-            int rd = read(
-                *itr,
-                &ie,
-                sizeof( ie ) );
+            switch ( xkb_compose_state_get_status( xkbComposeState ))
+            {
+            case XKB_COMPOSE_COMPOSING:
+                return;
+
+            case XKB_COMPOSE_COMPOSED:
+                unicode = xkb_keysym_to_utf32( xkb_compose_state_get_one_sym( xkbComposeState ));
+                xkb_compose_state_reset( xkbComposeState );
+                break;
+
+            case XKB_COMPOSE_CANCELLED:
+                xkb_compose_state_reset( xkbComposeState );
+                return;
 
-            while ( rd > 0 )
+            case XKB_COMPOSE_NOTHING:
+                unicode = xkb_state_key_get_utf32( xkbState, keycode );
+                break;
+            }
+        }
+        else
+            unicode = xkb_state_key_get_utf32( xkbState, keycode );
+
+        // Same text as the terminal gave: no escape and new lines for Return
+        if (( unicode == 0 ) || ( unicode == 27 ))
+            return;
+        if ( unicode == '\r' )
+            unicode = '\n';
+
+        sf::Event ev;
+        ev.type = sf::Event::TextEntered;
+        ev.text.unicode = unicode;
+        pushEvent( ev );
+    }
+#endif
+
+    // assumes inpMutex is locked
+    void processEvent( unsigned int deviceId, const struct input_event& ie )
+    {
+        sf::Event ev;
+
+        if ( ie.type == EV_KEY )
+        {
+            // Report a move held for coalescing first, to keep the order of the events
+            if ( motionPending )
+                pushMouseMoved();
+
+            sf::Mouse::Button mb = toMouseButton( ie.code );
+            if ( mb != sf::Mouse::ButtonCount )
             {
-                if ( ie.type == EV_KEY )
-                {
-                    sf::Mouse::Button mb = toMouseButton( ie.code );
-                    if ( mb != sf::Mouse::ButtonCount )
-                    {
-                        ev.type = ie.value ? sf::Event::MouseButtonPressed : sf::Event::MouseButtonReleased;
-                        ev.mouseButton.button = mb;
-                        ev.mouseButton.x = mousePos.x;
-                        ev.mouseButton.y = mousePos.y;
+                ev.type = ie.value ? sf::Event::MouseButtonPressed : sf::Event::MouseButtonReleased;
+                ev.mouseButton.button = mb;
+                ev.mouseButton.x = mousePos.x;
+                ev.mouseButton.y = mousePos.y;
 
-                        mouseMap[mb] = ie.value;
-                        return true;
-                    }
-                    else
+                mouseMap[mb] = ie.value;
+                pushEvent( ev );
+            }
+            else
+            {
+                sf::Keyboard::Key kb = toKey( ie.code );
+
+                // Backspace and DEL text events are generated based on
+                // keystrokes (and not stdin)
+                //
+                int special = 0;
+                if ( !keymapText && (( kb == sf::Keyboard::Delete )
+                        || ( kb == sf::Keyboard::BackSpace )))
+                    special = ( kb == sf::Keyboard::Delete ) ? 127 : 8;
+
+                if ( ie.value == 2 )
+                {
+                    // key repeat events
+                    //
+                    if ( special )
                     {
-                        sf::Keyboard::Key kb = toKey( ie.code );
-
-                        int special = 0;
-                        if (( kb == sf::Keyboard::Delete )
-                                || ( kb == sf::Keyboard::BackSpace ))
-                            special = ( kb == sf::Keyboard::Delete ) ? 127 : 8;
-
-                        if ( ie.value == 2 )
-                        {
-                            // key repeat events
-                            //
-                            if ( special )
-                            {
-                                ev.type = sf::Event::TextEntered;
-                                ev.text.unicode = special;
-                                return true;
-                            }
-                        }
-                        else if ( kb != sf::Keyboard::Unknown )
-                        {
-                            // key down and key up events
-                            //
-                            ev.type = ie.value ? sf::Event::KeyPressed : sf::Event::KeyReleased;
-                            ev.key.code = kb;
-                            ev.key.alt = altDown();
-                            ev.key.control = controlDown();
-                            ev.key.shift = shiftDown();
-                            ev.key.system = systemDown();
-
-                            keyMap[kb] = ie.value;
-
-                            if ( special && ie.value )
-                                doDeferredText = special;
-
-                            return true;
-                        }
+                        ev.type = sf::Event::TextEntered;
+                        ev.text.unicode = special;
+                        pushEvent( ev );
                     }
                 }
-                else if ( ie.type == EV_REL )
+                else if ( kb != sf::Keyboard::Unknown )
                 {
-                    bool posChange = false;
-                    switch ( ie.code )
-                    {
-                    case REL_X:
-                        mousePos.x += ie.value;
-                        posChange = true;
-                        break;
-
-                    case REL_Y:
-                        mousePos.y += ie.value;
-                        posChange = true;
-                        break;
-
-                    case REL_WHEEL:
-                        ev.type = sf::Event::MouseWheelMoved;
-                        ev.mouseWheel.delta = ie.value;
-                        ev.mouseWheel.x = mousePos.x;
-                        ev.mouseWheel.y = mousePos.y;
-                        return true;
-                    }
+                    // key down and key up events
+                    //
+                    ev.type = ie.value ? sf::Event::KeyPressed : sf::Event::KeyReleased;
+                    ev.key.code = kb;
+                    ev.key.alt = altDown();
+                    ev.key.control = controlDown();
+                    ev.key.shift = shiftDown();
+                    ev.key.system = systemDown();
+
+                    keyMap[kb] = ie.value;
+                    pushEvent( ev );
 
-                    if ( posChange )
+                    if ( special && ie.value )
                     {
-                        ev.type = sf::Event::MouseMoved;
-                        ev.mouseMove.x = mousePos.x;
-                        ev.mouseMove.y = mousePos.y;
-                        return true;
+                        ev.type = sf::Event::TextEntered;
+                        ev.text.unicode = special;
+                        pushEvent( ev );
                     }
                 }
-                else if ( ie.type == EV_ABS )
+
+#ifdef SFML_HAVE_XKBCOMMON
+                // Every key updates the keymap state, even the ones SFML doesn't know
+                if ( keymapText )
+                    processKeyText( ie );
+#endif
+            }
+        }
+        else if ( ie.type == EV_REL )
+        {
+            bool posChange = false;
+            switch ( ie.code )
+            {
+            case REL_X:
+                mousePos.x += ie.value;
+                posChange = true;
+                break;
+
+            case REL_Y:
+                mousePos.y += ie.value;
+                posChange = true;
+                break;
+
+            case REL_WHEEL:
+                if ( motionPending )
+                    pushMouseMoved();
+
+                ev.type = sf::Event::MouseWheelMoved;
+                ev.mouseWheel.delta = ie.value;
+                ev.mouseWheel.x = mousePos.x;
+                ev.mouseWheel.y = mousePos.y;
+                pushEvent( ev );
+                break;
+            }
+
+            if ( posChange )
+            {
+                // Keep the pointer on the screen
+                if (( mouseArea.x > 0 ) && ( mouseArea.y > 0 ))
                 {
-                    bool posChange = false;
-                    switch ( ie.code )
-                    {
-                    case ABS_X:
-                        mousePos.x = ie.value;
-                        posChange = true;
-                        break;
-
-                    case ABS_Y:
-                        mousePos.y = ie.value;
-                        posChange = true;
-                        break;
-                    case ABS_MT_SLOT:
-                        currentSlot = ie.value;
-                        touchFd = *itr;
-                        break;
-                    case ABS_MT_TRACKING_ID:
-                        atSlot(currentSlot).id = ie.value;
-                        touchFd = *itr;
-                        break;
-                    case ABS_MT_POSITION_X:
-                        atSlot(currentSlot).pos.x = ie.value;
-                        touchFd = *itr;
-                        break;
-                    case ABS_MT_POSITION_Y:
-                        atSlot(currentSlot).pos.y = ie.value;
-                        touchFd = *itr;
-                        break;
-                    }
-                    if ( posChange )
-                    {
-                        ev.type = sf::Event::MouseMoved;
-                        ev.mouseMove.x = mousePos.x;
-                        ev.mouseMove.y = mousePos.y;
-                        return true;
-                    }
+                    mousePos.x = std::max( 0, std::min( mousePos.x, static_cast<int>( mouseArea.x ) - 1 ));
+                    mousePos.y = std::max( 0, std::min( mousePos.y, static_cast<int>( mouseArea.y ) - 1 ));
                 }
-                else if ( ie.type == EV_SYN && ie.code == SYN_REPORT &&
-                          *itr == touchFd)
+
+                // When coalescing, wait for the end of the frame to
+                // report the X and Y changes as a single move
+                if ( coalesceMotion )
+                    motionPending = true;
+                else
+                    pushMouseMoved();
+            }
+        }
+        else if ( ie.type == EV_ABS )
+        {
+            bool posChange = false;
+            switch ( ie.code )
+            {
+            case ABS_X:
+                mousePos.x = ie.value;
+                posChange = true;
+                break;
+
+            case ABS_Y:
+                mousePos.y = ie.value;
+                posChange = true;
+                break;
+            case ABS_MT_SLOT:
+                currentSlot = ie.value;
+                touchDevice = deviceId;
+                break;
+            case ABS_MT_TRACKING_ID:
+                atSlot(currentSlot).id = ie.value;
+                touchDevice = deviceId;
+                break;
+            case ABS_MT_POSITION_X:
+                atSlot(currentSlot).pos.x = ie.value;
+                touchDevice = deviceId;
+                break;
+            case ABS_MT_POSITION_Y:
+                atSlot(currentSlot).pos.y = ie.value;
+                touchDevice = deviceId;
+                break;
+            }
+            if ( posChange )
+            {
+                // When coalescing, wait for the end of the frame to
+                // report the X and Y changes as a single move
+                if ( coalesceMotion )
+                    motionPending = true;
+                else
+                    pushMouseMoved();
+            }
+        }
+        else if ( ie.type == EV_SYN && ie.code == SYN_REPORT )
+        {
+            if ( motionPending )
+                pushMouseMoved();
+
+            // The touch slots are only complete at the end of a frame
+            if ( touchDevice == static_cast<int>( deviceId ))
+                processSlots();
+        }
+    }
+
+    // assumes inpMutex is locked
+    void readDevices()
+    {
+        // Drain each device with as few read() calls as possible.  evdev
+        // only ever returns whole input_events, so the events of a
+        // SYN_REPORT frame are converted together as they come in, and a
+        // frame split across two reads simply continues with the next one.
+        //
+        struct input_event buf[READ_SIZE];
+
+        for ( std::size_t d=0; d<devices.size(); d++ )
+        {
+            int fd = devices[d].fd;
+            ssize_t rd;
+            do
+            {
+                rd = read( fd, buf, sizeof( buf ) );
+
+                int count = ( rd > 0 ) ? rd / sizeof( struct input_event ) : 0;
+                for ( int i=0; i<count; i++ )
                 {
-                    // This pushes events directly to the queue, because it
-                    // can generate more than one event.
-                    processSlots();
+                    eventTime = toEventTime( devices[d], buf[i] );
+                    recordEvent( devices[d], buf[i] );
+                    processEvent( devices[d].id, buf[i] );
                 }
 
-                rd = read( *itr, &ie, sizeof( ie ) );
-            }
+            } while ( rd == sizeof( buf ) );
 
-            if (( rd < 0 ) && ( errno != EAGAIN ))
+            if (( rd < 0 ) && ( errno == ENODEV ))
+            {
+                // Unplugged, the udev monitor may not have told us yet
+                eventTime = monotonicTime();
+                closeDevice( d-- );
+            }
+            else if (( rd < 0 ) && ( errno != EAGAIN ))
                 sf::err() << " Error: " << strerror( errno ) << std::endl;
         }
+    }
+
+    // assumes inpMutex is locked
+    void processText( const unsigned char* buff, int rd )
+    {
+        for ( int i=0; i<rd; i++ )
+        {
+            unsigned char c = buff[i];
+
+            if (( c == 127 ) || ( c == 8 ))  // Suppress 127 (DEL) to 8 (BACKSPACE)
+                continue;
+            else if ( c == 27 )  // ESC
+                break;           // Suppress ANSI escape sequences
+
+            // TODO: Proper unicode handling
+            sf::Event ev;
+            ev.type = sf::Event::TextEntered;
+            ev.text.unicode = c;
+            pushEvent( ev );
+        }
+    }
 
-        // Finally check if there is a Text event on stdin
+    // assumes inpMutex is locked
+    void readText()
+    {
+        // Check if there is text on stdin
         //
         // We only clear the ICANON flag for the time of reading
 
@@ -532,7 +1159,8 @@ namespace
         tv.tv_sec = 0;
         tv.tv_usec = 0;
 
-        unsigned char c=0;
+        unsigned char buff[16];
+        int rd = 0;
 
         fd_set rdfs;
         FD_ZERO( &rdfs );
@@ -540,49 +1168,319 @@ namespace
         int sel = select( STDIN_FILENO+1, &rdfs, NULL, NULL, &tv );
 
         if ( sel > 0 && FD_ISSET( STDIN_FILENO, &rdfs ) )
-            read( STDIN_FILENO, &c, 1 );
-
-        if (( c == 127 ) || ( c == 8 ))  // Suppress 127 (DEL) to 8 (BACKSPACE)
-            c = 0;
-        else if ( c == 27 )  // ESC
-        {
-            // Suppress ANSI escape sequences
-            //
-            FD_ZERO( &rdfs );
-            FD_SET( STDIN_FILENO, &rdfs );
-            sel = select( STDIN_FILENO+1, &rdfs, NULL, NULL, &tv );
-            if ( sel > 0 && FD_ISSET( STDIN_FILENO, &rdfs ) )
+            rd = read( STDIN_FILENO, buff, sizeof( buff ) );
+
+        newt.c_lflag |= ICANON;
+        tcsetattr( STDIN_FILENO, TCSANOW, &newt );
+
+        eventTime = monotonicTime();
+
+        for ( int i=0; i<rd; i++ )
+            recordText( buff[i] );
+
+        processText( buff, rd );
+    }
+
+    bool readReplayRecord()
+    {
+        replayPending = ( fread( &replayRecord, sizeof( replayRecord ), 1, replayFile ) == 1 );
+        return replayPending;
+    }
+
+    void armReplayTimer()
+    {
+        // An all-zero expiration disarms the timer at the end of the recording
+        itimerspec timer;
+        memset( &timer, 0, sizeof( timer ));
+
+        if ( replayPending )
+        {
+            sf::Int64 due = ( replayStart.asMicroseconds() + replayRecord.time );
+            timer.it_value.tv_sec = due / 1000000;
+            timer.it_value.tv_nsec = ( due % 1000000 ) * 1000;
+        }
+
+        timerfd_settime( replayTimerFd, TFD_TIMER_ABSTIME, &timer, NULL );
+    }
+
+    // assumes inpMutex is locked
+    void replayRecords()
+    {
+        uint64_t expirations;
+        read( replayTimerFd, &expirations, sizeof( expirations ));
+
+        sf::Time now = monotonicTime();
+
+        while ( replayPending && ( replayStart + sf::microseconds( replayRecord.time ) <= now ))
+        {
+            InputRecord record = replayRecord;
+            readReplayRecord();
+
+            // The replayed events are timestamped as if they just happened
+            eventTime = replayStart + sf::microseconds( record.time );
+
+            switch ( record.kind )
+            {
+            case RecordEvent:
+            {
+                struct input_event ie;
+                memset( &ie, 0, sizeof( ie ));
+                ie.type = record.type;
+                ie.code = record.code;
+                ie.value = record.value;
+                processEvent( record.device, ie );
+                break;
+            }
+
+            case RecordConnect:
+            case RecordDisconnect:
             {
+                InputDevice device;
+                device.id = record.device;
+                device.fd = -1;
+                device.monotonic = true;
+                device.keyboard = ( record.flags & RecordKeyboard ) != 0;
+                device.mouse = ( record.flags & RecordMouse ) != 0;
+                device.touch = ( record.flags & RecordTouch ) != 0;
+
+                if ( record.kind == RecordConnect )
+                    pushDeviceEvent( sf::Event::InputDeviceConnected, device );
+                else
+                {
+                    if ( touchDevice == static_cast<int>( device.id ))
+                        touchDevice = -1;
+
+                    pushDeviceEvent( sf::Event::InputDeviceDisconnected, device );
+                }
+                break;
+            }
+
+            case RecordText:
+            {
+                // The text is converted from the replayed keys then
+                if ( keymapText )
+                    break;
+
+                // Characters read together are converted together
                 unsigned char buff[16];
-                int rd = read( STDIN_FILENO, buff, 16 );
-                c = 0;
+                int rd = 0;
+                buff[rd++] = record.value;
+
+                while ( replayPending && ( replayRecord.kind == RecordText )
+                        && ( replayRecord.time == record.time ) && ( rd < static_cast<int>( sizeof( buff ))))
+                {
+                    buff[rd++] = replayRecord.value;
+                    readReplayRecord();
+                }
+
+                processText( buff, rd );
+                break;
+            }
             }
         }
 
-        newt.c_lflag |= ICANON;
-        tcsetattr( STDIN_FILENO, TCSANOW, &newt );
+        armReplayTimer();
+    }
 
-        if ( c > 0 )
+    // Open the recording or the replay requested in the environment
+    void initRecording()
+    {
+        const char* replayPath = getenv( "SFML_INPUT_REPLAY" );
+        if ( replayPath )
         {
-            // TODO: Proper unicode handling
-            ev.type = sf::Event::TextEntered;
-            ev.text.unicode = c;
-            return true;
+            char magic[sizeof( RECORD_MAGIC )];
+
+            replayFile = fopen( replayPath, "rb" );
+            if ( !replayFile )
+                sf::err() << "Failed to open the input recording " << replayPath << ": " << strerror( errno ) << std::endl;
+            else if (( fread( magic, sizeof( magic ), 1, replayFile ) != 1 )
+                    || ( memcmp( magic, RECORD_MAGIC, sizeof( magic )) != 0 ))
+            {
+                sf::err() << replayPath << " is not an input recording" << std::endl;
+                fclose( replayFile );
+                replayFile = NULL;
+            }
+            else if (( replayTimerFd = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK )) < 0 )
+            {
+                sf::err() << "Failed to create the input replay timer: " << strerror( errno ) << std::endl;
+                fclose( replayFile );
+                replayFile = NULL;
+            }
+            else
+            {
+                replayStart = monotonicTime();
+                readReplayRecord();
+                armReplayTimer();
+            }
         }
 
-        // No events available
-        //
-        return false;
+        const char* recordPath = getenv( "SFML_INPUT_RECORD" );
+        if ( recordPath && !replayFile )
+        {
+            recordFile = fopen( recordPath, "wb" );
+            if ( !recordFile || ( fwrite( RECORD_MAGIC, sizeof( RECORD_MAGIC ), 1, recordFile ) != 1 ))
+            {
+                sf::err() << "Failed to create the input recording " << recordPath << ": " << strerror( errno ) << std::endl;
+                if ( recordFile )
+                    fclose( recordFile );
+                recordFile = NULL;
+            }
+
+            recordStart = monotonicTime();
+        }
     }
 
     // assumes inpMutex is locked
     void update()
     {
-        sf::Event ev;
-        while ( eventProcess( ev ) )
+        // A replay stands in for the devices and the terminal
+        if ( replayFile )
         {
-            pushEvent( ev );
+            replayRecords();
+            return;
         }
+
+        updateDevices();
+        readDevices();
+
+        if ( !keymapText )
+            readText();
+    }
+
+    void inputThreadMain()
+    {
+        std::vector<pollfd> pfds;
+
+        for (;;)
+        {
+            // The devices only change in update(), from this thread
+            {
+                sf::Lock lock( inpMutex );
+
+                pfds.clear();
+                pollfd pfd;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+
+                pfd.fd = stopFd;
+                pfds.push_back( pfd );
+
+                if ( replayFile )
+                {
+                    pfd.fd = replayTimerFd;
+                    pfds.push_back( pfd );
+                }
+
+                for ( std::vector<InputDevice>::iterator itr=devices.begin(); itr != devices.end(); ++itr )
+                {
+                    pfd.fd = itr->fd;
+                    pfds.push_back( pfd );
+                }
+
+                if ( udevMonitor )
+                {
+                    pfd.fd = udev_monitor_get_fd( udevMonitor );
+                    pfds.push_back( pfd );
+                }
+
+                if ( isatty( STDIN_FILENO ) && !replayFile && !keymapText )
+                {
+                    pfd.fd = STDIN_FILENO;
+                    pfds.push_back( pfd );
+                }
+            }
+
+            if (( poll( &pfds[0], pfds.size(), -1 ) < 0 ) && ( errno != EINTR ))
+            {
+                sf::err() << "Input thread failed to wait for events, reading the devices from the event loop instead: "
+                          << strerror( errno ) << std::endl;
+
+                // Go back to the synchronous update() of checkEvent(), and wake
+                // a waiting event loop up so that it watches the devices again
+                sf::Lock lock( inpMutex );
+                __atomic_store_n( &threaded, false, __ATOMIC_RELEASE );
+
+                uint64_t value = 1;
+                write( notifyFd, &value, sizeof( value ));
+                return;
+            }
+
+            if ( pfds[0].revents )
+                return;
+
+            sf::Lock lock( inpMutex );
+            unsigned int head = ringHead;
+
+            update();
+
+            if ( ringHead != head )
+            {
+                uint64_t value = 1;
+                write( notifyFd, &value, sizeof( value ));
+            }
+        }
+    }
+
+    void startInputThread()
+    {
+        notifyFd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+        stopFd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+        if (( notifyFd < 0 ) || ( stopFd < 0 ))
+        {
+            sf::err() << "Failed to create the input thread: " << strerror( errno ) << std::endl;
+            return;
+        }
+
+        threaded = true;
+        inputThread = new sf::Thread( &inputThreadMain );
+        inputThread->launch();
+    }
+
+    // assumes inpMutex is locked
+    void init()
+    {
+        static bool initialized = false;
+        if ( initialized )
+            return;
+
+        initialized=true;
+
+        initKeymap();
+        initRecording();
+
+        // Don't mix the input of the devices with a replay
+        if ( replayFile )
+            atexit( uninit );
+        else
+            initDevices();
+
+        coalesceMotion = ( getenv( "SFML_INPUT_COALESCE" ) != NULL );
+
+        if ( getenv( "SFML_INPUT_THREAD" ))
+            startInputThread();
+    }
+
+    bool popThreadedEvent( sf::Event& ev )
+    {
+        if ( !ringPop( ev ))
+        {
+            // Reset the notification before looking again, so that it stays
+            // set for events queued in between
+            uint64_t value;
+            read( notifyFd, &value, sizeof( value ));
+
+            if ( !ringPop( ev ))
+                return false;
+        }
+
+        // The input thread can't modify events the consumer may be
+        // reading, so runs of moves are merged here instead
+        sf::Event next;
+        while ( ringPeek( next ) && canCoalesce( ev, next ))
+            ringPop( ev );
+
+        return true;
     }
 };
 
@@ -597,7 +1495,10 @@ bool InputImpl::isKeyPressed(Keyboard::Key key)
     if (( key < 0 ) || ( key >= keyMap.size() ))
         return false;
 
-    update();
+    init();
+    if ( !threaded )
+        update();
+
     return keyMap[key];
 }
 
@@ -616,7 +1517,10 @@ bool InputImpl::isMouseButtonPressed(Mouse::Button button)
     if (( button < 0 ) || ( button >= mouseMap.size() ))
         return false;
 
-    update();
+    init();
+    if ( !threaded )
+        update();
+
     return mouseMap[button];
 }
 
@@ -641,6 +1545,9 @@ void InputImpl::setMousePosition(const Vector2i& position)
 {
     Lock lock( inpMutex );
     mousePos = position;
+
+    if ( mouseMovedCallback )
+        mouseMovedCallback( mousePos );
 }
 
 
@@ -654,6 +1561,7 @@ void InputImpl::setMousePosition(const Vector2i& position, const Window& relativ
 ////////////////////////////////////////////////////////////
 bool InputImpl::isTouchDown(unsigned int finger)
 {
+    Lock lock( inpMutex );
     for ( std::vector<TouchSlot>::iterator slot=touchSlots.begin(); slot != touchSlots.end(); ++slot )
     {
         if ( slot->id == finger )
@@ -667,6 +1575,7 @@ bool InputImpl::isTouchDown(unsigned int finger)
 ////////////////////////////////////////////////////////////
 Vector2i InputImpl::getTouchPosition(unsigned int finger)
 {
+    Lock lock( inpMutex );
     for ( std::vector<TouchSlot>::iterator slot=touchSlots.begin(); slot != touchSlots.end(); ++slot )
     {
         if ( slot->id == finger )
@@ -686,7 +1595,21 @@ Vector2i InputImpl::getTouchPosition(unsigned int finger, const Window& /*relati
 ////////////////////////////////////////////////////////////
 bool InputImpl::checkEvent( sf::Event &ev )
 {
+    // The input thread is started by init(), which the window already
+    // called through setTerminalConfig()
+    if ( __atomic_load_n( &threaded, __ATOMIC_ACQUIRE ))
+        return popThreadedEvent( ev );
+
+    // Events the input thread queued before it stopped come first
+    if ( ringPop( ev ))
+        return true;
+
     Lock lock( inpMutex );
+    init();
+
+    if ( eventQueue.empty() )
+        update();
+
     if ( !eventQueue.empty() )
     {
         ev = eventQueue.front();
@@ -695,24 +1618,6 @@ bool InputImpl::checkEvent( sf::Event &ev )
         return true;
     }
 
-    if ( eventProcess( ev ) )
-    {
-        return true;
-    }
-    else
-    {
-        // In the case of multitouch, eventProcess() could have returned false
-        // but added events directly to the queue.  (This is ugly, but I'm not
-        // sure of a good way to handle generating multiple events at once.)
-        if ( !eventQueue.empty() )
-        {
-            ev = eventQueue.front();
-            eventQueue.pop();
-
-            return true;
-        }
-    }
-
     return false;
 }
 
@@ -730,6 +1635,64 @@ void InputImpl::setTerminalConfig()
     tcflush(STDIN_FILENO, TCIFLUSH);         // flush the buffer
 }
 
+void InputImpl::setMouseMovedCallback( MouseMovedCallback callback )
+{
+    sf::Lock lock( inpMutex );
+    mouseMovedCallback = callback;
+}
+
+void InputImpl::setMouseArea( const Vector2u& size )
+{
+    sf::Lock lock( inpMutex );
+    mouseArea = size;
+}
+
+unsigned int InputImpl::getFileDescriptors( std::vector<int>& descriptors )
+{
+    sf::Lock lock( inpMutex );
+    init();
+
+    descriptors.clear();
+
+    // Only the input thread reads the devices then
+    if ( threaded )
+    {
+        descriptors.push_back( notifyFd );
+        return 0;
+    }
+
+    if ( replayFile )
+    {
+        descriptors.push_back( replayTimerFd );
+        return 0;
+    }
+
+    for ( std::vector<InputDevice>::iterator itr=devices.begin(); itr != devices.end(); ++itr )
+        descriptors.push_back( itr->fd );
+
+    if ( udevMonitor )
+        descriptors.push_back( udev_monitor_get_fd( udevMonitor ));
+
+    if ( isatty( STDIN_FILENO ) && !keymapText )
+        descriptors.push_back( STDIN_FILENO );
+
+    return deviceGeneration;
+}
+
+InputStatistics InputImpl::getStatistics()
+{
+    sf::Lock lock( inpMutex );
+    init();
+
+    InputStatistics statistics;
+    statistics.threaded = threaded;
+    statistics.queueCapacity = threaded ? RING_SIZE : MAX_QUEUE;
+    statistics.maxQueueSize = maxQueueSize;
+    statistics.queuedEvents = queuedEvents;
+    statistics.droppedEvents = droppedEvents;
+    return statistics;
+}
+
 void InputImpl::restoreTerminalConfig()
 {
     sf::Lock lock( inpMutex );
@@ -33,6 +33,9 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/InputStatistics.hpp>
+
+#include <vector>
 
 
 namespace sf
@@ -47,6 +50,8 @@ class InputImpl
 {
 public:
 
+    typedef void (*MouseMovedCallback)(const Vector2i& position);
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a key is pressed
     ///
@@ -167,6 +172,56 @@ public:
     static bool checkEvent( sf::Event &ev );
     static void setTerminalConfig();
     static void restoreTerminalConfig();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set a function called as soon as the mouse moves
+    ///
+    /// The callback runs from the input code itself, before the
+    /// event is queued, so that a hardware cursor can follow the
+    /// mouse without waiting for the application.
+    ///
+    /// \param callback Function to call, or NULL to remove it
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setMouseMovedCallback( MouseMovedCallback callback );
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the area the relative mouse moves are kept in
+    ///
+    /// Mice only report how much they moved, the position they
+    /// give is clamped to this area so that the cursor can't
+    /// leave the screen.
+    ///
+    /// \param size Size of the area in pixels, (0, 0) to not clamp
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setMouseArea( const Vector2u& size );
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that become readable when
+    ///        new input is available
+    ///
+    /// This covers the open input devices, the udev monitor that
+    /// reports devices being connected or disconnected and, when
+    /// it is a terminal, the standard input used for text events.
+    /// When the input thread reads the devices, it is instead a
+    /// single eventfd signaled when the thread queued events.
+    ///
+    /// \param descriptors Vector filled with the file descriptors
+    ///
+    /// \return Counter incremented each time a device is added or
+    ///         removed, as file descriptors may then be reused
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getFileDescriptors( std::vector<int>& descriptors );
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the input event queue
+    ///
+    /// \return Statistics of the input event queue
+    ///
+    ////////////////////////////////////////////////////////////
+    static InputStatistics getStatistics();
 };
 
 } // namespace priv
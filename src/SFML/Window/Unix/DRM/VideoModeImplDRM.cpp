@@ -32,6 +32,10 @@
 #include <SFML/Window/Unix/DRM/drm-common.h>
 #include <SFML/System/Err.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
 namespace sf
 {
 namespace priv
@@ -46,10 +50,15 @@ std::vector<VideoMode> VideoModeImpl::getFullscreenModes()
 
     if ( conn )
     {
+        // Connectors list some modes several times with different timings or flags
         for ( int i=0; i < conn->count_modes; i++ )
-            modes.push_back(
-                VideoMode( conn->modes[i].hdisplay,
-                    conn->modes[i].vdisplay ) );
+        {
+            VideoMode mode( conn->modes[i].hdisplay,
+                conn->modes[i].vdisplay, 32, conn->modes[i].vrefresh );
+
+            if ( std::find( modes.begin(), modes.end(), mode ) == modes.end() )
+                modes.push_back( mode );
+        }
     }
     else
         modes.push_back(getDesktopMode());
@@ -61,12 +70,24 @@ std::vector<VideoMode> VideoModeImpl::getFullscreenModes()
 ////////////////////////////////////////////////////////////
 VideoMode VideoModeImpl::getDesktopMode()
 {
-    struct drm *drm = sf::priv::DRMContext::get_drm();
-    drmModeModeInfoPtr m = drm->mode;
-    if ( m )
-        return VideoMode( m->hdisplay, m->vdisplay );
-    else
-        return VideoMode( 0, 0 );
+    // Without a display, pretend to have the mode given by "SFML_DRM_MODE" (1920x1080 if not set)
+    if ( sf::priv::DRMContext::isHeadless() )
+    {
+        unsigned int width = 1920;
+        unsigned int height = 1080;
+
+        const char *mode_str = getenv( "SFML_DRM_MODE" );
+        if ( mode_str && ( sscanf( mode_str, "%ux%u", &width, &height ) != 2 ))
+        {
+            width = 1920;
+            height = 1080;
+        }
+
+        return VideoMode( width, height );
+    }
+
+    // The mode SFML started with, fullscreen windows may have switched to another one since
+    return sf::priv::DRMContext::getDesktopMode();
 }
 
 } // namespace priv
@@ -34,11 +34,75 @@
 #include <SFML/Window/Unix/DRM/DRMContext.hpp>
 #include <SFML/Window/Unix/DRM/drm-common.h>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Err.hpp>
 
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <vector>
+
 ////////////////////////////////////////////////////////////
 // Private data
 ////////////////////////////////////////////////////////////
+namespace
+{
+    int epollFd = -1;             // epoll set watching all the event sources
+    int wakeUpFd = -1;            // eventfd written to interrupt a wait
+    std::vector<int> watchedFds;  // event sources currently in the epoll set
+    unsigned int watchedGeneration = 0;
+
+    void addToWaitSet( int fd )
+    {
+        epoll_event ev;
+        memset( &ev, 0, sizeof( ev ));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+
+        if ( epoll_ctl( epollFd, EPOLL_CTL_ADD, fd, &ev ) < 0 )
+            sf::err() << "Failed to watch file descriptor " << fd << ": " << strerror( errno ) << std::endl;
+    }
+
+    // Create the epoll set once, from the thread creating the windows, so
+    // that interruptWait() can be used from any thread afterwards
+    void initWaitSet()
+    {
+        if ( epollFd >= 0 )
+            return;
+
+        epollFd = epoll_create1( EPOLL_CLOEXEC );
+        wakeUpFd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+        if (( epollFd < 0 ) || ( wakeUpFd < 0 ))
+        {
+            sf::err() << "Failed to create the event wait set: " << strerror( errno ) << std::endl;
+            return;
+        }
+
+        addToWaitSet( wakeUpFd );
+    }
+
+    // Make the epoll set watch exactly the given event sources
+    void updateWaitSet( const std::vector<int>& fds, unsigned int generation )
+    {
+        // A closed fd leaves the epoll set by itself, the generation
+        // tells us when a new device may have reused its number
+        if (( fds == watchedFds ) && ( generation == watchedGeneration ))
+            return;
+
+        for ( std::vector<int>::const_iterator itr=watchedFds.begin(); itr != watchedFds.end(); ++itr )
+            epoll_ctl( epollFd, EPOLL_CTL_DEL, *itr, NULL ); // fails harmlessly for closed fds
+
+        for ( std::vector<int>::const_iterator itr=fds.begin(); itr != fds.end(); ++itr )
+            addToWaitSet( *itr );
+
+        watchedFds = fds;
+        watchedGeneration = generation;
+    }
+}
+
 namespace sf
 {
 namespace priv
@@ -47,25 +111,62 @@ namespace priv
 ////////////////////////////////////////////////////////////
 WindowImplDRM::WindowImplDRM(WindowHandle handle)
     : WindowImpl(),
-    m_size( 0, 0 )
+    m_size( 0, 0 ),
+    m_position( 0, 0 ),
+    m_style( Style::Fullscreen ),
+    m_output( 0 )
 {
     sf::priv::InputImpl::setTerminalConfig();
+    sf::priv::InputImpl::setMouseMovedCallback( sf::priv::DRMContext::moveCursor );
+    initWaitSet();
+
+    m_output = sf::priv::DRMContext::acquireOutput();
+    m_size = sf::priv::DRMContext::getOutputSize( m_output );
+
+    // The hardware cursor is shown on the primary output
+    sf::priv::InputImpl::setMouseArea( sf::priv::DRMContext::getOutputSize( 0 ));
 }
 
 
 ////////////////////////////////////////////////////////////
 WindowImplDRM::WindowImplDRM(VideoMode mode, const String& title, unsigned long style, const ContextSettings& settings)
     : WindowImpl(),
-    m_size( mode.width, mode.height )
-
+    m_size( mode.width, mode.height ),
+    m_position( 0, 0 ),
+    m_style( style ),
+    m_output( 0 )
 {
     sf::priv::InputImpl::setTerminalConfig();
+    sf::priv::InputImpl::setMouseMovedCallback( sf::priv::DRMContext::moveCursor );
+    initWaitSet();
+
+    // Overlay windows are shown on the primary output, the others take an output of their own.
+    // VideoMode only describes the primary output, so windows on the other ones use their mode
+    if ( !isOverlay() )
+    {
+        m_output = sf::priv::DRMContext::acquireOutput();
+        if ( m_output != 0 )
+            m_size = sf::priv::DRMContext::getOutputSize( m_output );
+        else if (( style & Style::Fullscreen ) && !sf::priv::DRMContext::isHeadless() )
+        {
+            // Fullscreen windows switch the primary output to their mode when it has another
+            // size or refresh rate, the context created next is sized for it and sets it
+            if ( !sf::priv::DRMContext::setOutputMode( 0, mode ))
+                m_size = sf::priv::DRMContext::getOutputSize( 0 );
+        }
+    }
+
+    // The hardware cursor is shown on the primary output
+    sf::priv::InputImpl::setMouseArea( sf::priv::DRMContext::getOutputSize( 0 ));
 }
 
 
 ////////////////////////////////////////////////////////////
 WindowImplDRM::~WindowImplDRM()
 {
+    if ( !isOverlay() )
+        sf::priv::DRMContext::releaseOutput( m_output );
+
     sf::priv::InputImpl::restoreTerminalConfig();
 }
 
@@ -80,13 +181,16 @@ WindowHandle WindowImplDRM::getSystemHandle() const
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplDRM::getPosition() const
 {
-    return Vector2i(0, 0);
+    return m_position;
 }
 
 
 ////////////////////////////////////////////////////////////
 void WindowImplDRM::setPosition(const Vector2i& position)
 {
+    // Only overlay windows can move, the plane picks it up on the next display()
+    if ( isOverlay() )
+        m_position = position;
 }
 
 
@@ -123,7 +227,14 @@ void WindowImplDRM::setVisible(bool visible)
 ////////////////////////////////////////////////////////////
 void WindowImplDRM::setMouseCursorVisible(bool visible)
 {
-    // TODO: not implemented
+    sf::priv::DRMContext::setCursorVisible( visible );
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplDRM::setMouseCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot)
+{
+    sf::priv::DRMContext::setCursorImage( width, height, pixels, hotspot );
 }
 
 
@@ -147,6 +258,16 @@ bool WindowImplDRM::hasFocus() const
     return true;
 }
 
+bool WindowImplDRM::isOverlay() const
+{
+    return ( m_style & Style::Overlay ) != 0;
+}
+
+unsigned int WindowImplDRM::getOutput() const
+{
+    return m_output;
+}
+
 void WindowImplDRM::processEvents()
 {
     sf::Event ev;
@@ -154,6 +275,65 @@ void WindowImplDRM::processEvents()
         pushEvent( ev );
 }
 
+InputStatistics WindowImplDRM::getInputStatistics() const
+{
+    return sf::priv::InputImpl::getStatistics();
+}
+
+bool WindowImplDRM::waitEvents(Time timeout)
+{
+    if (( epollFd < 0 ) || ( wakeUpFd < 0 ))
+        return false;
+
+    // Input devices (and stdin for text), joysticks, page flips and device connections
+    std::vector<int> fds;
+    unsigned int generation = sf::priv::InputImpl::getFileDescriptors( fds );
+    generation += sf::priv::JoystickImpl::getFileDescriptors( fds );
+
+    int drmFd = sf::priv::DRMContext::getEventFileDescriptor();
+    if ( drmFd >= 0 )
+        fds.push_back( drmFd );
+
+    updateWaitSet( fds, generation );
+
+    // Round up, so that we don't wake up just before the timeout expires
+    int ms = ( timeout < Time::Zero ) ? -1 : static_cast<int>(( timeout.asMicroseconds() + 999 ) / 1000 );
+
+    epoll_event events[16];
+    int count = epoll_wait( epollFd, events, 16, ms );
+
+    if (( count < 0 ) && ( errno != EINTR ))
+    {
+        sf::err() << "Failed to wait for events: " << strerror( errno ) << std::endl;
+        return false;
+    }
+
+    // The other sources are read by processEvents() and the joystick code
+    for ( int i=0; i<count; i++ )
+    {
+        if ( events[i].data.fd == wakeUpFd )
+        {
+            uint64_t value;
+            read( wakeUpFd, &value, sizeof( value ));
+        }
+        else if ( events[i].data.fd == drmFd )
+        {
+            sf::priv::DRMContext::dispatchEvents();
+        }
+    }
+
+    return true;
+}
+
+void WindowImplDRM::interruptWait()
+{
+    if ( wakeUpFd < 0 )
+        return;
+
+    uint64_t value = 1;
+    write( wakeUpFd, &value, sizeof( value ));
+}
+
 void WindowImplDRM::setMouseCursorGrabbed(bool grabbed)
 {
     //TODO: not implemented
@@ -146,6 +146,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setMouseCursorVisible(bool visible);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the image of the mouse cursor
+    ///
+    /// \param width   Cursor's width, in pixels
+    /// \param height  Cursor's height, in pixels
+    /// \param pixels  Pointer to the pixels in memory, format must be RGBA 32 bits
+    /// \param hotspot Position of the hotspot in the image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -169,6 +180,30 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the input event queue
+    ///
+    /// \return Statistics of the input event queue
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual InputStatistics getInputStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the window is shown on an overlay plane
+    ///
+    /// \return True if the window was created with Style::Overlay
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOverlay() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the output the window is shown on
+    ///
+    /// \return Index of the output, 0 being the primary output
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getOutput() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -177,8 +212,28 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the input devices, the DRM device or the
+    ///        joystick monitor have new events
+    ///
+    /// \param timeout Maximum time to wait, negative to wait forever
+    ///
+    /// \return False if the wait failed
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Interrupt a call to waitEvents() from another thread
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void interruptWait();
+
 private:
     Vector2u m_size;
+    Vector2i m_position;
+    unsigned long m_style;
+    unsigned int m_output;
 };
 
 } // namespace priv
@@ -196,13 +196,56 @@ static int find_drm_device(drmModeRes **resources)
 	return fd;
 }
 
+static drmModeModeInfo *find_mode(drmModeConnector *connector,
+		const char *mode_str, unsigned int vrefresh)
+{
+	drmModeModeInfo *mode = NULL;
+	int i, area;
+
+	/* find user requested mode: */
+	if (mode_str && *mode_str) {
+		for (i = 0; i < connector->count_modes; i++) {
+			drmModeModeInfo *current_mode = &connector->modes[i];
+
+			if (strcmp(current_mode->name, mode_str) == 0) {
+				if (vrefresh == 0 || current_mode->vrefresh == vrefresh) {
+					mode = current_mode;
+					break;
+				}
+			}
+		}
+		if (!mode)
+			printf("requested mode not found, using default mode!\n");
+	}
+
+	/* find preferred mode or the highest resolution mode: */
+	if (!mode) {
+		for (i = 0, area = 0; i < connector->count_modes; i++) {
+			drmModeModeInfo *current_mode = &connector->modes[i];
+
+			if (current_mode->type & DRM_MODE_TYPE_PREFERRED) {
+				mode = current_mode;
+				break;
+			}
+
+			int current_area = current_mode->hdisplay * current_mode->vdisplay;
+			if (current_area > area) {
+				mode = current_mode;
+				area = current_area;
+			}
+		}
+	}
+
+	return mode;
+}
+
 int init_drm(struct drm *drm, const char *device, const char *mode_str,
 		unsigned int vrefresh )
 {
 	drmModeRes *resources;
 	drmModeConnector *connector = NULL;
 	drmModeEncoder *encoder = NULL;
-	int i, ret, area;
+	int i, ret;
 
 	if (device) {
 		drm->fd = open(device, O_RDWR);
@@ -242,40 +285,7 @@ int init_drm(struct drm *drm, const char *device, const char *mode_str,
 		return -1;
 	}
 
-	/* find user requested mode: */
-	if (mode_str && *mode_str) {
-		for (i = 0; i < connector->count_modes; i++) {
-			drmModeModeInfo *current_mode = &connector->modes[i];
-
-			if (strcmp(current_mode->name, mode_str) == 0) {
-				if (vrefresh == 0 || current_mode->vrefresh == vrefresh) {
-					drm->mode = current_mode;
-					break;
-				}
-			}
-		}
-		if (!drm->mode)
-			printf("requested mode not found, using default mode!\n");
-	}
-
-	/* find preferred mode or the highest resolution mode: */
-	if (!drm->mode) {
-		for (i = 0, area = 0; i < connector->count_modes; i++) {
-			drmModeModeInfo *current_mode = &connector->modes[i];
-
-			if (current_mode->type & DRM_MODE_TYPE_PREFERRED) {
-				drm->mode = current_mode;
-				break;
-			}
-
-			int current_area = current_mode->hdisplay * current_mode->vdisplay;
-			if (current_area > area) {
-				drm->mode = current_mode;
-				area = current_area;
-			}
-		}
-	}
-
+	drm->mode = find_mode(connector, mode_str, vrefresh);
 	if (!drm->mode) {
 		printf("could not find mode!\n");
 		return -1;
@@ -318,3 +328,332 @@ int init_drm(struct drm *drm, const char *device, const char *mode_str,
 
 	return 0;
 }
+
+static int id_in_list(uint32_t id, const uint32_t *list, int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (list[i] == id)
+			return 1;
+	}
+
+	return 0;
+}
+
+int init_drm_output(struct drm *drm, int fd,
+		const uint32_t *used_connectors, const uint32_t *used_crtcs, int count_used)
+{
+	drmModeRes *resources;
+	drmModeConnector *connector = NULL;
+	drmModeEncoder *encoder = NULL;
+	uint32_t crtc_id = 0;
+	int i, j, k;
+
+	memset(drm, 0, sizeof(*drm));
+	drm->fd = fd;
+
+	resources = drmModeGetResources(fd);
+	if (!resources) {
+		printf("drmModeGetResources failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	/* find a connected connector that isn't driven yet, and a free crtc for it: */
+	for (i = 0; i < resources->count_connectors && !crtc_id; i++) {
+		if (id_in_list(resources->connectors[i], used_connectors, count_used))
+			continue;
+
+		connector = drmModeGetConnector(fd, resources->connectors[i]);
+		if (!connector)
+			continue;
+
+		if (connector->connection == DRM_MODE_CONNECTED) {
+			/* prefer the crtc the connector is already driven by: */
+			encoder = drmModeGetEncoder(fd, connector->encoder_id);
+			if (encoder && encoder->crtc_id && !id_in_list(encoder->crtc_id, used_crtcs, count_used))
+				crtc_id = encoder->crtc_id;
+
+			for (j = 0; j < connector->count_encoders && !crtc_id; j++) {
+				drmModeEncoder *e = drmModeGetEncoder(fd, connector->encoders[j]);
+
+				if (!e)
+					continue;
+
+				for (k = 0; k < resources->count_crtcs; k++) {
+					if ((e->possible_crtcs & (1 << k)) &&
+					    !id_in_list(resources->crtcs[k], used_crtcs, count_used)) {
+						crtc_id = resources->crtcs[k];
+						break;
+					}
+				}
+				drmModeFreeEncoder(e);
+			}
+		}
+
+		if (!crtc_id) {
+			drmModeFreeEncoder(encoder);
+			drmModeFreeConnector(connector);
+			encoder = NULL;
+			connector = NULL;
+		}
+	}
+
+	drmModeFreeResources(resources);
+
+	if (!connector)
+		return -1;
+
+	drm->mode = find_mode(connector, NULL, 0);
+	if (!drm->mode) {
+		printf("could not find mode for connector %u!\n", connector->connector_id);
+		drmModeFreeEncoder(encoder);
+		drmModeFreeConnector(connector);
+		return -1;
+	}
+
+	drm->crtc_id = crtc_id;
+	drm->connector_id = connector->connector_id;
+
+	drm->saved_connector = connector;
+	drm->saved_encoder = encoder;
+
+	drm->original_crtc = drmModeGetCrtc(fd, crtc_id);
+
+	if (getenv("SFML_DRM_DEBUG")) {
+		printf("DRM Mode used on connector %u: %s@%d\n", drm->connector_id,
+			drm->mode->name, drm->mode->vrefresh);
+	}
+
+	return 0;
+}
+
+static int get_properties(int fd, uint32_t id, uint32_t type,
+		drmModeObjectProperties **props, drmModePropertyRes ***props_info)
+{
+	unsigned int i;
+
+	*props = drmModeObjectGetProperties(fd, id, type);
+	if (!*props) {
+		printf("could not get properties of object %u: %s\n", id, strerror(errno));
+		return -1;
+	}
+
+	*props_info = calloc((*props)->count_props, sizeof(**props_info));
+	for (i = 0; i < (*props)->count_props; i++)
+		(*props_info)[i] = drmModeGetProperty(fd, (*props)->props[i]);
+
+	return 0;
+}
+
+static void free_properties(drmModeObjectProperties *props,
+		drmModePropertyRes **props_info)
+{
+	unsigned int i;
+
+	if (!props)
+		return;
+
+	for (i = 0; i < props->count_props; i++)
+		drmModeFreeProperty(props_info[i]);
+
+	free(props_info);
+	drmModeFreeObjectProperties(props);
+}
+
+static int add_property(drmModeAtomicReq *req, uint32_t obj_id,
+		drmModeObjectProperties *props, drmModePropertyRes **props_info,
+		const char *name, uint64_t value)
+{
+	unsigned int i;
+
+	for (i = 0; i < props->count_props; i++) {
+		if (props_info[i] && strcmp(props_info[i]->name, name) == 0)
+			return drmModeAtomicAddProperty(req, obj_id, props_info[i]->prop_id, value);
+	}
+
+	return -EINVAL;
+}
+
+int drm_add_connector_property(struct drm *drm, drmModeAtomicReq *req,
+		const char *name, uint64_t value)
+{
+	struct connector *obj = drm->connector;
+
+	return add_property(req, obj->connector->connector_id,
+			obj->props, obj->props_info, name, value);
+}
+
+int drm_add_crtc_property(struct drm *drm, drmModeAtomicReq *req,
+		const char *name, uint64_t value)
+{
+	struct crtc *obj = drm->crtc;
+
+	return add_property(req, obj->crtc->crtc_id,
+			obj->props, obj->props_info, name, value);
+}
+
+int drm_add_plane_property(struct drm *drm, drmModeAtomicReq *req,
+		struct plane *plane, const char *name, uint64_t value)
+{
+	(void)drm;
+
+	return add_property(req, plane->plane->plane_id,
+			plane->props, plane->props_info, name, value);
+}
+
+struct plane * drm_get_plane(struct drm *drm, uint64_t type)
+{
+	int i;
+
+	for (i = 0; i < drm->count_planes; i++) {
+		struct plane *plane = &drm->planes[i];
+
+		if (!plane->in_use && plane->type == type) {
+			plane->in_use = 1;
+			return plane;
+		}
+	}
+
+	/* no free plane of this type for our crtc */
+	return NULL;
+}
+
+void drm_put_plane(struct plane *plane)
+{
+	if (plane)
+		plane->in_use = 0;
+}
+
+int init_drm_atomic(struct drm *drm)
+{
+	drmModeRes *resources;
+	drmModePlaneRes *plane_resources;
+	uint32_t crtc_mask = 0;
+	unsigned int i, j;
+
+	if (drmSetClientCap(drm->fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1)) {
+		printf("no universal planes support\n");
+		return -1;
+	}
+
+	if (drmSetClientCap(drm->fd, DRM_CLIENT_CAP_ATOMIC, 1)) {
+		printf("no atomic modesetting support\n");
+		return -1;
+	}
+
+	resources = drmModeGetResources(drm->fd);
+	if (!resources) {
+		printf("drmModeGetResources failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	/* planes advertise the crtcs they can be used with by index: */
+	for (i = 0; i < (unsigned int)resources->count_crtcs; i++) {
+		if (resources->crtcs[i] == drm->crtc_id) {
+			crtc_mask = 1 << i;
+			break;
+		}
+	}
+	drmModeFreeResources(resources);
+
+	plane_resources = drmModeGetPlaneResources(drm->fd);
+	if (!plane_resources) {
+		printf("drmModeGetPlaneResources failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	drm->count_planes = 0;
+	for (i = 0; i < plane_resources->count_planes && drm->count_planes < MAX_PLANES; i++) {
+		drmModePlane *p = drmModeGetPlane(drm->fd, plane_resources->planes[i]);
+		struct plane *plane;
+
+		if (!p)
+			continue;
+
+		if (!(p->possible_crtcs & crtc_mask)) {
+			drmModeFreePlane(p);
+			continue;
+		}
+
+		plane = &drm->planes[drm->count_planes];
+		memset(plane, 0, sizeof(*plane));
+		plane->plane = p;
+
+		if (get_properties(drm->fd, p->plane_id, DRM_MODE_OBJECT_PLANE,
+				&plane->props, &plane->props_info)) {
+			drmModeFreePlane(p);
+			continue;
+		}
+
+		plane->type = DRM_PLANE_TYPE_OVERLAY;
+		for (j = 0; j < plane->props->count_props; j++) {
+			if (plane->props_info[j] && strcmp(plane->props_info[j]->name, "type") == 0)
+				plane->type = plane->props->prop_values[j];
+		}
+
+		drm->count_planes++;
+	}
+	drmModeFreePlaneResources(plane_resources);
+
+	drm->crtc = calloc(1, sizeof(*drm->crtc));
+	drm->crtc->crtc = drmModeGetCrtc(drm->fd, drm->crtc_id);
+	if (!drm->crtc->crtc || get_properties(drm->fd, drm->crtc_id, DRM_MODE_OBJECT_CRTC,
+			&drm->crtc->props, &drm->crtc->props_info)) {
+		free_drm_atomic(drm);
+		return -1;
+	}
+
+	drm->connector = calloc(1, sizeof(*drm->connector));
+	drm->connector->connector = drmModeGetConnector(drm->fd, drm->connector_id);
+	if (!drm->connector->connector || get_properties(drm->fd, drm->connector_id, DRM_MODE_OBJECT_CONNECTOR,
+			&drm->connector->props, &drm->connector->props_info)) {
+		free_drm_atomic(drm);
+		return -1;
+	}
+
+	if (drmModeCreatePropertyBlob(drm->fd, drm->mode, sizeof(*drm->mode), &drm->mode_blob_id)) {
+		printf("failed to create mode property blob: %s\n", strerror(errno));
+		free_drm_atomic(drm);
+		return -1;
+	}
+
+	drm->atomic = 1;
+
+	if (getenv("SFML_DRM_DEBUG"))
+		printf("DRM atomic modesetting enabled, %d planes available\n", drm->count_planes);
+
+	return 0;
+}
+
+void free_drm_atomic(struct drm *drm)
+{
+	int i;
+
+	for (i = 0; i < drm->count_planes; i++) {
+		free_properties(drm->planes[i].props, drm->planes[i].props_info);
+		drmModeFreePlane(drm->planes[i].plane);
+	}
+	drm->count_planes = 0;
+
+	if (drm->crtc) {
+		free_properties(drm->crtc->props, drm->crtc->props_info);
+		drmModeFreeCrtc(drm->crtc->crtc);
+		free(drm->crtc);
+		drm->crtc = NULL;
+	}
+
+	if (drm->connector) {
+		free_properties(drm->connector->props, drm->connector->props_info);
+		drmModeFreeConnector(drm->connector->connector);
+		free(drm->connector);
+		drm->connector = NULL;
+	}
+
+	if (drm->mode_blob_id) {
+		drmModeDestroyPropertyBlob(drm->fd, drm->mode_blob_id);
+		drm->mode_blob_id = 0;
+	}
+
+	drm->atomic = 0;
+}
@@ -34,10 +34,15 @@ extern "C" {
 struct gbm;
 struct egl;
 
+#define MAX_PLANES 16
+#define MAX_OUTPUTS 8
+
 struct plane {
 	drmModePlane *plane;
 	drmModeObjectProperties *props;
 	drmModePropertyRes **props_info;
+	uint64_t type;
+	int in_use;
 };
 
 struct crtc {
@@ -63,6 +68,14 @@ struct drm {
 
     drmModeConnectorPtr saved_connector;
     drmModeEncoderPtr saved_encoder;
+
+	/* only valid when atomic modesetting is enabled: */
+	int atomic;
+	uint32_t mode_blob_id;
+	struct crtc *crtc;
+	struct connector *connector;
+	struct plane planes[MAX_PLANES];
+	int count_planes;
 };
 
 struct drm_fb {
@@ -73,6 +86,17 @@ struct drm_fb {
 struct drm_fb * drm_fb_get_from_bo(struct gbm_bo *bo);
 
 int init_drm(struct drm *drm, const char *device, const char *mode_str, unsigned int vrefresh);
+int init_drm_output(struct drm *drm, int fd, const uint32_t *used_connectors, const uint32_t *used_crtcs, int count_used);
+
+int init_drm_atomic(struct drm *drm);
+void free_drm_atomic(struct drm *drm);
+
+struct plane * drm_get_plane(struct drm *drm, uint64_t type);
+void drm_put_plane(struct plane *plane);
+
+int drm_add_connector_property(struct drm *drm, drmModeAtomicReq *req, const char *name, uint64_t value);
+int drm_add_crtc_property(struct drm *drm, drmModeAtomicReq *req, const char *name, uint64_t value);
+int drm_add_plane_property(struct drm *drm, drmModeAtomicReq *req, struct plane *plane, const char *name, uint64_t value);
 
 #ifdef __cplusplus
 }
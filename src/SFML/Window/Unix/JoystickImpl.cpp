@@ -27,11 +27,13 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Err.hpp>
-#include <linux/joystick.h>
 #include <libudev.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/ioctl.h>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -51,6 +53,69 @@ namespace
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    struct OpenJoystick
+    {
+        int  file;
+        bool readable;
+    };
+
+    // Open joysticks, polled together by hasPendingEvents()
+    std::vector<OpenJoystick> openJoysticks;
+    unsigned int openGeneration = 0;
+
+    // Joysticks found by the initial scan, before any udev event, wait to be opened
+    bool scanPending = false;
+
+    // Number of events read from a joystick per read() call
+    const int ReadSize = 64;
+
+    bool testBit(const unsigned long* bits, unsigned int bit)
+    {
+        const unsigned int bitsPerLong = sizeof(unsigned long) * 8;
+        return (bits[bit / bitsPerLong] >> (bit % bitsPerLong)) & 1;
+    }
+
+    sf::Time monotonicTime()
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return sf::microseconds(static_cast<sf::Int64>(now.tv_sec) * 1000000 + now.tv_nsec / 1000);
+    }
+
+    bool isReadable(int file)
+    {
+        for (std::vector<OpenJoystick>::iterator it = openJoysticks.begin(); it != openJoysticks.end(); ++it)
+        {
+            if (it->file == file)
+            {
+                bool readable = it->readable;
+                it->readable = false;
+                return readable;
+            }
+        }
+
+        return true;
+    }
+
+    // Map a joystick axis code to the SFML axis, -1 if not supported
+    int getAxis(unsigned int code)
+    {
+        switch (code)
+        {
+            case ABS_X:        return sf::Joystick::X;
+            case ABS_Y:        return sf::Joystick::Y;
+            case ABS_Z:
+            case ABS_THROTTLE: return sf::Joystick::Z;
+            case ABS_RZ:
+            case ABS_RUDDER:   return sf::Joystick::R;
+            case ABS_RX:       return sf::Joystick::U;
+            case ABS_RY:       return sf::Joystick::V;
+            case ABS_HAT0X:    return sf::Joystick::PovX;
+            case ABS_HAT0Y:    return sf::Joystick::PovY;
+            default:           return -1;
+        }
+    }
+
     bool isJoystick(udev_device* udevDevice)
     {
         // If anything goes wrong, we go safe and return true
@@ -65,8 +130,8 @@ namespace
         if (!devnode)
             return false;
 
-        // SFML doesn't support evdev yet, so make sure we only handle /js nodes
-        if (!std::strstr(devnode, "/js"))
+        // Joysticks are read through evdev, so make sure we only handle /event nodes
+        if (!std::strstr(devnode, "/event"))
             return false;
 
         // Check if this device is a joystick
@@ -396,7 +461,7 @@ namespace
     {
         std::string devnode = joystickList[index].deviceNode;
 
-        // First try using ioctl with JSIOCGNAME
+        // First try using ioctl with EVIOCGNAME
         int fd = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK);
 
         if (fd >= 0)
@@ -405,7 +470,7 @@ namespace
             char name[128];
             std::memset(name, 0, sizeof(name));
 
-            int result = ioctl(fd, JSIOCGNAME(sizeof(name)), name);
+            int result = ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name);
 
             ::close(fd);
 
@@ -441,9 +506,13 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 JoystickImpl::JoystickImpl() :
-m_file(-1)
+m_file     (-1),
+m_monotonic(false)
 {
-    std::fill(m_mapping, m_mapping + ABS_MAX + 1, 0);
+    std::fill(m_axisMapping, m_axisMapping + ABS_MAX + 1, -1);
+    std::fill(m_buttonMapping, m_buttonMapping + KEY_MAX - BTN_MISC + 1, -1);
+    std::fill(m_axisMin, m_axisMin + Joystick::AxisCount, 0);
+    std::fill(m_axisMax, m_axisMax + Joystick::AxisCount, 0);
 }
 
 
@@ -489,8 +558,9 @@ void JoystickImpl::initialize()
         }
     }
 
-    // Do an initial scan
+    // Do an initial scan, the first update must open what it found
     updatePluggedList();
+    scanPending = true;
 }
 
 
@@ -542,6 +612,59 @@ bool JoystickImpl::isConnected(unsigned int index)
     return joystickList[index].plugged;
 }
 
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::hasPendingEvents()
+{
+    // Nothing is open yet when the joysticks of the initial scan are reported
+    if (scanPending)
+    {
+        scanPending = false;
+        return true;
+    }
+
+    // Without a monitor, connections can only be found by scanning
+    if (!udevMonitor)
+        return true;
+
+    std::vector<pollfd> descriptors(openJoysticks.size() + 1);
+    for (std::size_t i = 0; i < openJoysticks.size(); ++i)
+    {
+        descriptors[i].fd = openJoysticks[i].file;
+        descriptors[i].events = POLLIN;
+        descriptors[i].revents = 0;
+    }
+
+    // This will not fail since we make sure udevMonitor is valid
+    pollfd& monitor = descriptors.back();
+    monitor.fd = udev_monitor_get_fd(udevMonitor);
+    monitor.events = POLLIN;
+    monitor.revents = 0;
+
+    if (poll(&descriptors[0], descriptors.size(), 0) <= 0)
+        return false;
+
+    // Errors and hang-ups count as readable, read() then reports the disconnection
+    for (std::size_t i = 0; i < openJoysticks.size(); ++i)
+        openJoysticks[i].readable = (descriptors[i].revents != 0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int JoystickImpl::getFileDescriptors(std::vector<int>& fds)
+{
+    for (std::vector<OpenJoystick>::const_iterator it = openJoysticks.begin(); it != openJoysticks.end(); ++it)
+        fds.push_back(it->file);
+
+    if (udevMonitor)
+        fds.push_back(udev_monitor_get_fd(udevMonitor));
+
+    return openGeneration;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
@@ -556,8 +679,51 @@ bool JoystickImpl::open(unsigned int index)
         m_file = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK);
         if (m_file >= 0)
         {
-            // Retrieve the axes mapping
-            ioctl(m_file, JSIOCGAXMAP, m_mapping);
+            // Have the kernel timestamp the events with the clock used by sf::Clock
+            m_monotonic = false;
+#ifdef EVIOCSCLOCKID
+            int clock = CLOCK_MONOTONIC;
+            m_monotonic = (ioctl(m_file, EVIOCSCLOCKID, &clock) == 0);
+#endif
+
+            unsigned long keyBits[KEY_MAX / (sizeof(unsigned long) * 8) + 1];
+            unsigned long absBits[ABS_MAX / (sizeof(unsigned long) * 8) + 1];
+            std::memset(keyBits, 0, sizeof(keyBits));
+            std::memset(absBits, 0, sizeof(absBits));
+            ioctl(m_file, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+            ioctl(m_file, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+
+            // Retrieve the axes mapping and range, the first code wins
+            // when several of them map to the same axis
+            m_capabilities = JoystickCaps();
+            std::fill(m_axisMapping, m_axisMapping + ABS_MAX + 1, -1);
+            for (unsigned int code = 0; code <= ABS_MAX; ++code)
+            {
+                int axis = getAxis(code);
+                if ((axis < 0) || !testBit(absBits, code) || m_capabilities.axes[axis])
+                    continue;
+
+                input_absinfo info;
+                if (ioctl(m_file, EVIOCGABS(code), &info) < 0)
+                    continue;
+
+                m_axisMapping[code] = axis;
+                m_axisMin[axis] = info.minimum;
+                m_axisMax[axis] = info.maximum;
+                m_capabilities.axes[axis] = true;
+            }
+
+            // Number the buttons like the joystick driver does: joystick
+            // and gamepad buttons first, then the other buttons
+            std::fill(m_buttonMapping, m_buttonMapping + KEY_MAX - BTN_MISC + 1, -1);
+            for (unsigned int i = 0; i <= KEY_MAX - BTN_MISC; ++i)
+            {
+                unsigned int code = (i <= KEY_MAX - BTN_JOYSTICK) ? BTN_JOYSTICK + i : BTN_MISC + i - (KEY_MAX - BTN_JOYSTICK + 1);
+                if (!testBit(keyBits, code) || (m_capabilities.buttonCount >= Joystick::ButtonCount))
+                    continue;
+
+                m_buttonMapping[code - BTN_MISC] = m_capabilities.buttonCount++;
+            }
 
             // Get info
             m_identification.name = getJoystickName(index);
@@ -568,8 +734,16 @@ bool JoystickImpl::open(unsigned int index)
                 m_identification.productId = getJoystickProductId(index);
             }
 
-            // Reset the joystick state
+            // evdev doesn't send the initial state, so read it
             m_state = JoystickState();
+            m_state.connected = true;
+            synchronize();
+
+            OpenJoystick openJoystick;
+            openJoystick.file = m_file;
+            openJoystick.readable = false;
+            openJoysticks.push_back(openJoystick);
+            ++openGeneration;
 
             return true;
         }
@@ -586,6 +760,16 @@ bool JoystickImpl::open(unsigned int index)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::close()
 {
+    for (std::vector<OpenJoystick>::iterator it = openJoysticks.begin(); it != openJoysticks.end(); ++it)
+    {
+        if (it->file == m_file)
+        {
+            openJoysticks.erase(it);
+            ++openGeneration;
+            break;
+        }
+    }
+
     ::close(m_file);
     m_file = -1;
 }
@@ -594,40 +778,7 @@ void JoystickImpl::close()
 ////////////////////////////////////////////////////////////
 JoystickCaps JoystickImpl::getCapabilities() const
 {
-    JoystickCaps caps;
-
-    if (m_file < 0)
-        return caps;
-
-    // Get the number of buttons
-    char buttonCount;
-    ioctl(m_file, JSIOCGBUTTONS, &buttonCount);
-    caps.buttonCount = buttonCount;
-    if (caps.buttonCount > Joystick::ButtonCount)
-        caps.buttonCount = Joystick::ButtonCount;
-
-    // Get the supported axes
-    char axesCount;
-    ioctl(m_file, JSIOCGAXES, &axesCount);
-    for (int i = 0; i < axesCount; ++i)
-    {
-        switch (m_mapping[i])
-        {
-            case ABS_X:        caps.axes[Joystick::X]    = true; break;
-            case ABS_Y:        caps.axes[Joystick::Y]    = true; break;
-            case ABS_Z:
-            case ABS_THROTTLE: caps.axes[Joystick::Z]    = true; break;
-            case ABS_RZ:
-            case ABS_RUDDER:   caps.axes[Joystick::R]    = true; break;
-            case ABS_RX:       caps.axes[Joystick::U]    = true; break;
-            case ABS_RY:       caps.axes[Joystick::V]    = true; break;
-            case ABS_HAT0X:    caps.axes[Joystick::PovX] = true; break;
-            case ABS_HAT0Y:    caps.axes[Joystick::PovY] = true; break;
-            default:           break;
-        }
-    }
-
-    return caps;
+    return m_capabilities;
 }
 
 
@@ -639,7 +790,7 @@ Joystick::Identification JoystickImpl::getIdentification() const
 
 
 ////////////////////////////////////////////////////////////
-JoystickState JoystickImpl::JoystickImpl::update()
+JoystickState JoystickImpl::update()
 {
     if (m_file < 0)
     {
@@ -647,62 +798,117 @@ JoystickState JoystickImpl::JoystickImpl::update()
         return m_state;
     }
 
-    // pop events from the joystick file
-    js_event joyState;
-    int result = read(m_file, &joyState, sizeof(joyState));
-    while (result > 0)
+    // Nothing to read if the last poll didn't report this joystick
+    if (!isReadable(m_file))
+        return m_state;
+
+    // Pop the events from the joystick file, a batch at a time
+    input_event events[ReadSize];
+    for (;;)
     {
-        switch (joyState.type & ~JS_EVENT_INIT)
+        ssize_t result = read(m_file, events, sizeof(events));
+
+        // read() fails with ENODEV once the joystick is unplugged
+        if (result < 0)
         {
-            // An axis was moved
-            case JS_EVENT_AXIS:
+            if ((errno != EAGAIN) && (errno != EINTR))
+                m_state.connected = false;
+            break;
+        }
+
+        int count = static_cast<int>(result / sizeof(input_event));
+        for (int i = 0; i < count; ++i)
+        {
+            const input_event& event = events[i];
+
+            switch (event.type)
             {
-                float value = joyState.value * 100.f / 32767.f;
+                // An axis was moved
+                case EV_ABS:
+                {
+                    if (event.code <= ABS_MAX)
+                        setAxis(event.code, event.value);
+                    break;
+                }
 
-                if (joyState.number < ABS_MAX + 1)
+                // A button was pressed or released (ignore the key repeats)
+                case EV_KEY:
                 {
-                    switch (m_mapping[joyState.number])
+                    if ((event.code >= BTN_MISC) && (event.code <= KEY_MAX) && (event.value != 2))
                     {
-                        case ABS_X:        m_state.axes[Joystick::X]    = value; break;
-                        case ABS_Y:        m_state.axes[Joystick::Y]    = value; break;
-                        case ABS_Z:
-                        case ABS_THROTTLE: m_state.axes[Joystick::Z]    = value; break;
-                        case ABS_RZ:
-                        case ABS_RUDDER:   m_state.axes[Joystick::R]    = value; break;
-                        case ABS_RX:       m_state.axes[Joystick::U]    = value; break;
-                        case ABS_RY:       m_state.axes[Joystick::V]    = value; break;
-                        case ABS_HAT0X:    m_state.axes[Joystick::PovX] = value; break;
-                        case ABS_HAT0Y:    m_state.axes[Joystick::PovY] = value; break;
-                        default:           break;
+                        int button = m_buttonMapping[event.code - BTN_MISC];
+                        if (button >= 0)
+                            m_state.buttons[button] = (event.value != 0);
                     }
+                    break;
                 }
-                break;
-            }
 
-            // A button was pressed
-            case JS_EVENT_BUTTON:
-            {
-                if (joyState.number < Joystick::ButtonCount)
-                    m_state.buttons[joyState.number] = (joyState.value != 0);
-                break;
+                // The kernel dropped events, so read the state again
+                case EV_SYN:
+                {
+                    if (event.code == SYN_DROPPED)
+                        synchronize();
+                    break;
+                }
             }
+
+            if (m_monotonic)
+                m_state.timestamp = microseconds(static_cast<Int64>(event.time.tv_sec) * 1000000 + event.time.tv_usec);
+            else
+                m_state.timestamp = monotonicTime();
         }
 
-        result = read(m_file, &joyState, sizeof(joyState));
+        // A short read means that the queue is empty
+        if (count < ReadSize)
+            break;
     }
 
-    // Check the connection state of the joystick
-    // read() returns -1 and errno != EGAIN if it's no longer connected
-    // We need to check the result of read() as well, since errno could
-    // have been previously set by some other function call that failed
-    // result can be either negative or 0 at this point
-    // If result is 0, assume the joystick is still connected
-    // If result is negative, check errno and disconnect if it is not EAGAIN
-    m_state.connected = (!result || (errno == EAGAIN));
-
     return m_state;
 }
 
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::synchronize()
+{
+    for (unsigned int code = 0; code <= ABS_MAX; ++code)
+    {
+        input_absinfo info;
+        if ((m_axisMapping[code] >= 0) && (ioctl(m_file, EVIOCGABS(code), &info) >= 0))
+            setAxis(code, info.value);
+    }
+
+    unsigned long keyState[KEY_MAX / (sizeof(unsigned long) * 8) + 1];
+    std::memset(keyState, 0, sizeof(keyState));
+    if (ioctl(m_file, EVIOCGKEY(sizeof(keyState)), keyState) >= 0)
+    {
+        for (unsigned int code = BTN_MISC; code <= KEY_MAX; ++code)
+        {
+            int button = m_buttonMapping[code - BTN_MISC];
+            if (button >= 0)
+                m_state.buttons[button] = testBit(keyState, code);
+        }
+    }
+
+    m_state.timestamp = monotonicTime();
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::setAxis(unsigned int code, int value)
+{
+    int axis = m_axisMapping[code];
+    if (axis < 0)
+        return;
+
+    // Scale the value from the range of the axis to [-100, 100]
+    int minimum = m_axisMin[axis];
+    int maximum = m_axisMax[axis];
+    if (maximum > minimum)
+        m_state.axes[axis] = (static_cast<float>(value) - minimum) * 200.f / (maximum - minimum) - 100.f;
+    else
+        m_state.axes[axis] = 0.f;
+}
+
 } // namespace priv
 
 } // namespace sf
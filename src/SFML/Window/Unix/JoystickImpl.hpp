@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <linux/input.h>
+#include <vector>
 
 
 namespace sf
@@ -72,6 +73,34 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if any joystick has something to report
+    ///
+    /// This polls the open joysticks and the udev monitor once,
+    /// and remembers which of them are readable so that update()
+    /// only reads these. The first call after initialize() always
+    /// returns true, so that the joysticks plugged in before are
+    /// opened.
+    ///
+    /// \return True if a joystick or the udev monitor is readable,
+    ///         or if the initial scan wasn't reported yet
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool hasPendingEvents();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that report joystick input
+    ///        and connections
+    ///
+    /// \param fds Vector to fill with the file descriptors of the
+    ///            open joysticks and of the udev monitor
+    ///
+    /// \return Counter that changes whenever a joystick is opened
+    ///         or closed, so that callers know when to refresh
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getFileDescriptors(std::vector<int>& fds);
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -117,10 +146,34 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    int                          m_file;                 ///< File descriptor of the joystick
-    char                         m_mapping[ABS_MAX + 1]; ///< Axes mapping (index to axis id)
-    JoystickState                m_state;                ///< Current state of the joystick
-    sf::Joystick::Identification m_identification;       ///< Identification of the joystick
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the current position of every axis and the
+    ///        status of every button from the device
+    ///
+    ////////////////////////////////////////////////////////////
+    void synchronize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the new value of an absolute axis
+    ///
+    /// \param code  Axis code (ABS_*)
+    /// \param value Raw value reported by the device
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAxis(unsigned int code, int value);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    int                          m_file;                                  ///< File descriptor of the joystick
+    bool                         m_monotonic;                             ///< Are event times on the monotonic clock?
+    int                          m_axisMapping[ABS_MAX + 1];              ///< Axes mapping (axis code to axis id, -1 if unused)
+    int                          m_buttonMapping[KEY_MAX - BTN_MISC + 1]; ///< Buttons mapping (key code - BTN_MISC to button index, -1 if unused)
+    int                          m_axisMin[Joystick::AxisCount];          ///< Minimum raw value of each axis
+    int                          m_axisMax[Joystick::AxisCount];          ///< Maximum raw value of each axis
+    JoystickCaps                 m_capabilities;                          ///< Capabilities of the joystick
+    JoystickState                m_state;                                 ///< Current state of the joystick
+    sf::Joystick::Identification m_identification;                        ///< Identification of the joystick
 };
 
 } // namespace priv
@@ -42,6 +42,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <time.h>
 #include <libgen.h>
 #include <fcntl.h>
 #include <algorithm>
@@ -117,6 +118,44 @@ namespace
         return "sfml";
     }
 
+    // Current time in the time base used by sf::Clock
+    sf::Time monotonicTime()
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return sf::microseconds(static_cast<sf::Int64>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+    }
+
+    // Time of an X event in the time base used by sf::Clock
+    sf::Time getEventTime(const XEvent& event)
+    {
+        ::Time serverTime;
+
+        switch (event.type)
+        {
+            case KeyPress:
+            case KeyRelease:     serverTime = event.xkey.time;      break;
+            case ButtonPress:
+            case ButtonRelease:  serverTime = event.xbutton.time;   break;
+            case MotionNotify:   serverTime = event.xmotion.time;   break;
+            case EnterNotify:
+            case LeaveNotify:    serverTime = event.xcrossing.time; break;
+            default:             return monotonicTime();
+        }
+
+        // The server time is a 32-bit counter of milliseconds which, for a
+        // local server on Linux, comes from the same monotonic clock: use
+        // how long ago it was, modulo 2^32, to convert it
+        sf::Time now = monotonicTime();
+        sf::Uint32 age = static_cast<sf::Uint32>(now.asMilliseconds()) - static_cast<sf::Uint32>(serverTime);
+
+        // Remote server or different clock: use the time of reception instead
+        if (age > 10000)
+            return now;
+
+        return now - sf::milliseconds(static_cast<sf::Int32>(age));
+    }
+
     // Check if Extended Window Manager Hints are supported
     bool ewmhSupported()
     {
@@ -1411,6 +1450,9 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
         }
     }
 
+    // Time at which the event occurred
+    Time timestamp = getEventTime(windowEvent);
+
     // Convert the X11 event to a sf::Event
     switch (windowEvent.type)
     {
@@ -1453,6 +1495,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
 
             Event event;
             event.type = Event::GainedFocus;
+            event.timestamp = timestamp;
             pushEvent(event);
 
             // If the window has been previously marked urgent (notification) as a result of a focus request, undo that
@@ -1481,6 +1524,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
 
             Event event;
             event.type = Event::LostFocus;
+            event.timestamp = timestamp;
             pushEvent(event);
             break;
         }
@@ -1495,6 +1539,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                 event.type        = Event::Resized;
                 event.size.width  = windowEvent.xconfigure.width;
                 event.size.height = windowEvent.xconfigure.height;
+                event.timestamp   = timestamp;
                 pushEvent(event);
 
                 m_previousSize.x = windowEvent.xconfigure.width;
@@ -1519,6 +1564,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                     // Handle the WM_DELETE_WINDOW message
                     Event event;
                     event.type = Event::Closed;
+                    event.timestamp = timestamp;
                     pushEvent(event);
                 }
                 else if (netWmPing && (windowEvent.xclient.format == 32) && (windowEvent.xclient.data.l[0]) == static_cast<long>(netWmPing))
@@ -1556,6 +1602,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
             event.key.control = windowEvent.xkey.state & ControlMask;
             event.key.shift   = windowEvent.xkey.state & ShiftMask;
             event.key.system  = windowEvent.xkey.state & Mod4Mask;
+            event.timestamp   = timestamp;
             pushEvent(event);
 
             // Generate a TextEntered event
@@ -1585,6 +1632,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                             Event textEvent;
                             textEvent.type         = Event::TextEntered;
                             textEvent.text.unicode = unicode;
+                            textEvent.timestamp    = timestamp;
                             pushEvent(textEvent);
                         }
                     }
@@ -1599,6 +1647,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                         Event textEvent;
                         textEvent.type         = Event::TextEntered;
                         textEvent.text.unicode = static_cast<Uint32>(keyBuffer[0]);
+                        textEvent.timestamp    = timestamp;
                         pushEvent(textEvent);
                     }
                 }
@@ -1632,6 +1681,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
             event.key.control = windowEvent.xkey.state & ControlMask;
             event.key.shift   = windowEvent.xkey.state & ShiftMask;
             event.key.system  = windowEvent.xkey.state & Mod4Mask;
+            event.timestamp   = timestamp;
             pushEvent(event);
 
             break;
@@ -1661,6 +1711,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                     case 8:       event.mouseButton.button = Mouse::XButton1; break;
                     case 9:       event.mouseButton.button = Mouse::XButton2; break;
                 }
+                event.timestamp = timestamp;
                 pushEvent(event);
             }
 
@@ -1691,6 +1742,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                     case 8:       event.mouseButton.button = Mouse::XButton1; break;
                     case 9:       event.mouseButton.button = Mouse::XButton2; break;
                 }
+                event.timestamp = timestamp;
                 pushEvent(event);
             }
             else if ((button == Button4) || (button == Button5))
@@ -1701,6 +1753,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                 event.mouseWheel.delta = (button == Button4) ? 1 : -1;
                 event.mouseWheel.x     = windowEvent.xbutton.x;
                 event.mouseWheel.y     = windowEvent.xbutton.y;
+                event.timestamp        = timestamp;
                 pushEvent(event);
 
                 event.type                   = Event::MouseWheelScrolled;
@@ -1708,6 +1761,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                 event.mouseWheelScroll.delta = (button == Button4) ? 1 : -1;
                 event.mouseWheelScroll.x     = windowEvent.xbutton.x;
                 event.mouseWheelScroll.y     = windowEvent.xbutton.y;
+                event.timestamp              = timestamp;
                 pushEvent(event);
             }
             else if ((button == 6) || (button == 7))
@@ -1718,6 +1772,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
                 event.mouseWheelScroll.delta = (button == 6) ? 1 : -1;
                 event.mouseWheelScroll.x     = windowEvent.xbutton.x;
                 event.mouseWheelScroll.y     = windowEvent.xbutton.y;
+                event.timestamp              = timestamp;
                 pushEvent(event);
             }
             break;
@@ -1730,6 +1785,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
             event.type        = Event::MouseMoved;
             event.mouseMove.x = windowEvent.xmotion.x;
             event.mouseMove.y = windowEvent.xmotion.y;
+            event.timestamp   = timestamp;
             pushEvent(event);
             break;
         }
@@ -1741,6 +1797,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
             {
                 Event event;
                 event.type = Event::MouseEntered;
+                event.timestamp = timestamp;
                 pushEvent(event);
             }
             break;
@@ -1753,6 +1810,7 @@ bool WindowImplX11::processEvent(XEvent& windowEvent)
             {
                 Event event;
                 event.type = Event::MouseLeft;
+                event.timestamp = timestamp;
                 pushEvent(event);
             }
             break;
@@ -37,17 +37,19 @@ namespace sf
 VideoMode::VideoMode() :
 width       (0),
 height      (0),
-bitsPerPixel(0)
+bitsPerPixel(0),
+refreshRate (0)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-VideoMode::VideoMode(unsigned int modeWidth, unsigned int modeHeight, unsigned int modeBitsPerPixel) :
+VideoMode::VideoMode(unsigned int modeWidth, unsigned int modeHeight, unsigned int modeBitsPerPixel, unsigned int modeRefreshRate) :
 width       (modeWidth),
 height      (modeHeight),
-bitsPerPixel(modeBitsPerPixel)
+bitsPerPixel(modeBitsPerPixel),
+refreshRate (modeRefreshRate)
 {
 
 }
@@ -82,7 +84,17 @@ bool VideoMode::isValid() const
 {
     const std::vector<VideoMode>& modes = getFullscreenModes();
 
-    return std::find(modes.begin(), modes.end(), *this) != modes.end();
+    if (refreshRate != 0)
+        return std::find(modes.begin(), modes.end(), *this) != modes.end();
+
+    // Any refresh rate will do
+    for (std::vector<VideoMode>::const_iterator it = modes.begin(); it != modes.end(); ++it)
+    {
+        if ((it->width == width) && (it->height == height) && (it->bitsPerPixel == bitsPerPixel))
+            return true;
+    }
+
+    return false;
 }
 
 
@@ -91,7 +103,8 @@ bool operator ==(const VideoMode& left, const VideoMode& right)
 {
     return (left.width        == right.width)        &&
            (left.height       == right.height)       &&
-           (left.bitsPerPixel == right.bitsPerPixel);
+           (left.bitsPerPixel == right.bitsPerPixel) &&
+           (left.refreshRate  == right.refreshRate);
 }
 
 
@@ -109,7 +122,14 @@ bool operator <(const VideoMode& left, const VideoMode& right)
     {
         if (left.width == right.width)
         {
-            return left.height < right.height;
+            if (left.height == right.height)
+            {
+                return left.refreshRate < right.refreshRate;
+            }
+            else
+            {
+                return left.height < right.height;
+            }
         }
         else
         {
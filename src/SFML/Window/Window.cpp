@@ -30,11 +30,17 @@
 #include <SFML/Window/WindowImpl.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
 
 
 namespace
 {
     const sf::Window* fullscreenWindow = NULL;
+
+    // sleep() may overshoot by the granularity of the scheduler,
+    // so the end of a precise wait is spent spinning instead
+    const sf::Time spinTime = sf::milliseconds(1);
 }
 
 
@@ -42,10 +48,13 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Window::Window() :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl           (NULL),
+m_context        (NULL),
+m_frameTimeLimit (Time::Zero),
+m_nextFrameTime  (Time::Zero),
+m_lastFrameCount (0),
+m_missedDeadlines(0),
+m_size           (0, 0)
 {
 
 }
@@ -53,10 +62,13 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl           (NULL),
+m_context        (NULL),
+m_frameTimeLimit (Time::Zero),
+m_nextFrameTime  (Time::Zero),
+m_lastFrameCount (0),
+m_missedDeadlines(0),
+m_size           (0, 0)
 {
     create(mode, title, style, settings);
 }
@@ -64,10 +76,13 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl           (NULL),
+m_context        (NULL),
+m_frameTimeLimit (Time::Zero),
+m_nextFrameTime  (Time::Zero),
+m_lastFrameCount (0),
+m_missedDeadlines(0),
+m_size           (0, 0)
 {
     create(handle, settings);
 }
@@ -209,6 +224,28 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::waitEvent(Event& event, Time timeout)
+{
+    if (m_impl && m_impl->popEvent(event, std::max(timeout, Time::Zero)))
+    {
+        return filterEvent(event);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::wakeUp()
+{
+    if (m_impl)
+        m_impl->wakeUp();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -288,6 +325,14 @@ void Window::setMouseCursorVisible(bool visible)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setMouseCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot)
+{
+    if (m_impl)
+        m_impl->setMouseCursorImage(width, height, pixels, hotspot);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setMouseCursorGrabbed(bool grabbed)
 {
@@ -311,6 +356,10 @@ void Window::setFramerateLimit(unsigned int limit)
         m_frameTimeLimit = seconds(1.f / limit);
     else
         m_frameTimeLimit = Time::Zero;
+
+    // Start a new cadence from the current frame
+    m_nextFrameTime = m_clock.getElapsedTime();
+    m_lastFrameCount = 0;
 }
 
 
@@ -365,14 +414,31 @@ void Window::display()
 {
     // Display the backbuffer on screen
     if (setActive())
+    {
+        onDisplay();
         m_context->display();
+    }
 
     // Limit the framerate if needed
     if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+        waitForNextFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+FrameTiming Window::getFrameTiming() const
+{
+    FrameTiming timing = m_context ? m_context->getFrameTiming() : FrameTiming();
+    timing.missedDeadlines = m_missedDeadlines;
+
+    return timing;
+}
+
+
+////////////////////////////////////////////////////////////
+InputStatistics Window::getInputStatistics() const
+{
+    return m_impl ? m_impl->getInputStatistics() : InputStatistics();
 }
 
 
@@ -397,6 +463,28 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setDamage(const Int32* rects, unsigned int count)
+{
+    if (m_context)
+        m_context->setDamage(rects, count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Window::getBufferAge() const
+{
+    return m_context ? m_context->getBufferAge() : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {
@@ -415,6 +503,64 @@ bool Window::filterEvent(const Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::waitForNextFrame()
+{
+    FrameTiming timing = m_context ? m_context->getFrameTiming() : FrameTiming();
+
+    if ((timing.refreshPeriod != Time::Zero) && (timing.presentTime != Time::Zero))
+    {
+        // Present every n-th refresh cycle, n being the smallest number
+        // of cycles that doesn't exceed the limit (30 Hz on a 60 Hz display
+        // shows each frame for 2 cycles), with some tolerance for displays
+        // that refresh slightly faster than their nominal rate
+        Uint64 cycles = static_cast<Uint64>(std::max(1.f, std::ceil(m_frameTimeLimit / timing.refreshPeriod - 0.05f)));
+
+        // A frame that stayed on screen longer than its cycles missed its deadline
+        if (timing.frameCount != m_lastFrameCount)
+        {
+            if ((m_lastFrameCount != 0) && (timing.frameCount - m_lastFrameCount > cycles))
+                ++m_missedDeadlines;
+
+            m_lastFrameCount = timing.frameCount;
+        }
+
+        // Synchronized page flips already give the cadence of one frame per cycle
+        if ((cycles == 1) && m_context->isVerticalSyncActive())
+            return;
+
+        // The frame just displayed shows at the next vertical blank; the next
+        // one must not be queued before the blank preceding its own cycle, or
+        // it would be shown too early. A small margin protects from waking up
+        // just before that blank
+        Time wakeUp = timing.nextVblank + timing.refreshPeriod * static_cast<Int64>(cycles - 1) + milliseconds(1);
+        if (m_context->sleepUntil(wakeUp))
+            return;
+    }
+
+    // Without display timing, keep a steady cadence from the clock: the
+    // deadlines are spaced by the limit instead of measured from the end of
+    // the previous wait, so that the overshoots don't accumulate
+    Time now = m_clock.getElapsedTime();
+    m_nextFrameTime += m_frameTimeLimit;
+
+    if (now > m_nextFrameTime)
+    {
+        // Too late: start a new cadence rather than rushing the next frames
+        ++m_missedDeadlines;
+        m_nextFrameTime = now;
+        return;
+    }
+
+    if (m_nextFrameTime - now > spinTime)
+        sleep(m_nextFrameTime - now - spinTime);
+
+    while (m_clock.getElapsedTime() < m_nextFrameTime)
+    {
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::initialize()
 {
@@ -430,6 +576,8 @@ void Window::initialize()
 
     // Reset frame time
     m_clock.restart();
+    m_nextFrameTime = Time::Zero;
+    m_lastFrameCount = 0;
 
     // Activate the window
     setActive();
@@ -29,6 +29,8 @@
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/JoystickManager.hpp>
 #include <SFML/Window/SensorManager.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <algorithm>
 #include <cmath>
@@ -89,7 +91,8 @@ WindowImpl* WindowImpl::create(WindowHandle handle)
 
 ////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl() :
-m_joystickThreshold(0.1f)
+m_joystickThreshold(0.1f),
+m_wakeUpRequested  (false)
 {
     // Get the initial joystick states
     JoystickManager::getInstance().update();
@@ -119,8 +122,30 @@ void WindowImpl::setJoystickThreshold(float threshold)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::setMouseCursorImage(unsigned int /*width*/, unsigned int /*height*/, const Uint8* /*pixels*/, const Vector2u& /*hotspot*/)
+{
+    // Not supported by default
+}
+
+
+////////////////////////////////////////////////////////////
+InputStatistics WindowImpl::getInputStatistics() const
+{
+    // Not supported by default
+    return InputStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool WindowImpl::popEvent(Event& event, bool block)
+{
+    return popEvent(event, block ? microseconds(-1) : Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::popEvent(Event& event, Time timeout)
 {
     // If the event queue is empty, let's first check if new events are available from the OS
     if (m_events.empty())
@@ -130,19 +155,35 @@ bool WindowImpl::popEvent(Event& event, bool block)
         processSensorEvents();
         processEvents();
 
-        // In blocking mode, we must process events until one is triggered
-        if (block)
+        // A negative timeout blocks until an event is triggered
+        bool forever = (timeout < Time::Zero);
+        Clock clock;
+
+        while (m_events.empty())
         {
-            // Here we use a manual wait loop instead of the optimized
-            // wait-event provided by the OS, so that we don't skip joystick
-            // events (which require polling)
-            while (m_events.empty())
+            Time remaining = forever ? timeout : timeout - clock.getElapsedTime();
+            if (!forever && (remaining <= Time::Zero))
+                break;
+
+            // Only a wait with a timeout can be interrupted, a request made
+            // while no wait was in progress interrupts the next one
+            if (!forever)
             {
-                sleep(milliseconds(10));
-                processJoystickEvents();
-                processSensorEvents();
-                processEvents();
+                Lock lock(m_wakeUpMutex);
+                if (m_wakeUpRequested)
+                {
+                    m_wakeUpRequested = false;
+                    break;
+                }
             }
+
+            // Here we use a manual wait loop if the OS can't wait for us
+            if (!waitEvents(remaining))
+                sleep(forever ? milliseconds(10) : std::min(remaining, milliseconds(10)));
+
+            processJoystickEvents();
+            processSensorEvents();
+            processEvents();
         }
     }
 
@@ -159,6 +200,15 @@ bool WindowImpl::popEvent(Event& event, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::wakeUp()
+{
+    Lock lock(m_wakeUpMutex);
+    m_wakeUpRequested = true;
+    interruptWait();
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImpl::pushEvent(const Event& event)
 {
@@ -166,6 +216,21 @@ void WindowImpl::pushEvent(const Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool WindowImpl::waitEvents(Time /*timeout*/)
+{
+    // Not supported by default
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::interruptWait()
+{
+    // Nothing to interrupt by default
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImpl::processJoystickEvents()
 {
@@ -185,6 +250,7 @@ void WindowImpl::processJoystickEvents()
         {
             Event event;
             event.type = connected ? Event::JoystickConnected : Event::JoystickDisconnected;
+            event.timestamp = m_joystickStates[i].timestamp;
             event.joystickButton.joystickId = i;
             pushEvent(event);
 
@@ -207,6 +273,7 @@ void WindowImpl::processJoystickEvents()
                     {
                         Event event;
                         event.type = Event::JoystickMoved;
+                        event.timestamp = m_joystickStates[i].timestamp;
                         event.joystickMove.joystickId = i;
                         event.joystickMove.axis = axis;
                         event.joystickMove.position = currPos;
@@ -227,6 +294,7 @@ void WindowImpl::processJoystickEvents()
                 {
                     Event event;
                     event.type = currPressed ? Event::JoystickButtonPressed : Event::JoystickButtonReleased;
+                    event.timestamp = m_joystickStates[i].timestamp;
                     event.joystickButton.joystickId = i;
                     event.joystickButton.button = j;
                     pushEvent(event);
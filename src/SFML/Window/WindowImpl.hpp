@@ -29,9 +29,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/InputStatistics.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/Window/Sensor.hpp>
@@ -112,6 +115,29 @@ public:
     ////////////////////////////////////////////////////////////
     bool popEvent(Event& event, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next window event available, waiting
+    ///        at most a given time for it
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event
+    ///
+    /// \return True if an event was returned, false if the timeout
+    ///         expired or wakeUp() was called first
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popEvent(Event& event, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a pending popEvent() with a timeout return
+    ///        without an event
+    ///
+    /// This function can be called from any thread. When no such
+    /// call is waiting, the next one returns without waiting.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wakeUp();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -186,6 +212,19 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setMouseCursorVisible(bool visible) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the image of the mouse cursor
+    ///
+    /// The default implementation keeps the system cursor.
+    ///
+    /// \param width   Cursor's width, in pixels
+    /// \param height  Cursor's height, in pixels
+    /// \param pixels  Pointer to the pixels in memory, format must be RGBA 32 bits
+    /// \param hotspot Position of the hotspot in the image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseCursorImage(unsigned int width, unsigned int height, const Uint8* pixels, const Vector2u& hotspot);
+
     ////////////////////////////////////////////////////////////
     /// \brief Grab or release the mouse cursor and keeps it from leaving
     ///
@@ -217,6 +256,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the input event queue
+    ///
+    /// \return Statistics of the input event queue
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual InputStatistics getInputStatistics() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -243,6 +290,30 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the operating system has new events
+    ///
+    /// Implementations that can block on the OS event sources
+    /// override this function so that popEvent() doesn't have
+    /// to poll. It may return early, for example when wakeUp()
+    /// is called, processEvents() is called afterwards anyway.
+    /// Joysticks are only read after it returns, so it must also
+    /// return when a joystick has something to report.
+    ///
+    /// \param timeout Maximum time to wait, negative to wait forever
+    ///
+    /// \return False if waiting is not supported, in which case the
+    ///         caller polls processEvents() at regular intervals
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Interrupt a call to waitEvents() from another thread
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void interruptWait();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -265,6 +336,8 @@ private:
     Vector3f          m_sensorValue[Sensor::Count];                          ///< Previous value of the sensors
     float             m_joystickThreshold;                                   ///< Joystick threshold (minimum motion for "move" event to be generated)
     float             m_previousAxes[Joystick::Count][Joystick::AxisCount];  ///< Position of each axis last time a move event triggered, in range [-100, 100]
+    Mutex             m_wakeUpMutex;                                         ///< Protects m_wakeUpRequested
+    bool              m_wakeUpRequested;                                     ///< Was wakeUp() called without interrupting a wait yet?
 };
 
 } // namespace priv